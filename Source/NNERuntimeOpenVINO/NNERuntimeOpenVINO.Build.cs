@@ -33,10 +33,12 @@ public class NNERuntimeOpenVINO : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"AssetRegistry",
 				"Core",
 				"CoreUObject",
 				"Engine",
-				"Projects"
+				"Projects",
+				"XmlParser"
 			}
 		);
 
@@ -47,5 +49,17 @@ public class NNERuntimeOpenVINO : ModuleRules
 				"OpenVino"
 			}
 		);
+
+		if (Target.bBuildEditor)
+		{
+			// Required to precompile models for the cook target and cache compiled models in the DDC.
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"DerivedDataCache",
+					"TargetPlatform"
+				}
+			);
+		}
 	}
 }
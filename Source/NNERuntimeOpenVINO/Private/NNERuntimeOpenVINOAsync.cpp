@@ -0,0 +1,64 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "NNERuntimeOpenVINOAsync.h"
+
+FNNERuntimeOpenVINOAsyncRequest::FNNERuntimeOpenVINOAsyncRequest(const UObject* InOwner)
+	: Owner(InOwner)
+	, bHasOwner(InOwner != nullptr)
+{
+}
+
+void FNNERuntimeOpenVINOAsyncRequest::Cancel()
+{
+	bCancelled = true;
+}
+
+bool FNNERuntimeOpenVINOAsyncRequest::IsCancelled() const
+{
+	// Use the thread safe test as this is polled from the worker thread while the GC may be running.
+	return bCancelled || (bHasOwner && !Owner.IsValid(false, true));
+}
+
+float FNNERuntimeOpenVINOAsyncRequest::GetProgress() const
+{
+	return Progress;
+}
+
+bool FNNERuntimeOpenVINOAsyncRequest::IsDone() const
+{
+	return bDone;
+}
+
+void FNNERuntimeOpenVINOAsyncRequest::SetProgress(float InProgress)
+{
+	Progress = FMath::Clamp(InProgress, 0.0f, 1.0f);
+}
+
+void FNNERuntimeOpenVINOAsyncRequest::MarkDone()
+{
+	Progress = 1.0f;
+	bDone = true;
+}
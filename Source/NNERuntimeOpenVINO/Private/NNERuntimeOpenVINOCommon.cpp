@@ -24,10 +24,193 @@
 
 #include "NNERuntimeOpenVINOCommon.h"
 
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeTryLock.h"
+#include "UObject/GarbageCollection.h"
 #include "Modules/ModuleManager.h"
 #include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
+#include "NNERuntimeOpenVINODaemon.h"
+#include "NNERuntimeOpenVINOIRRewrite.h"
+#include "NNERuntimeOpenVINOMemoryBudget.h"
 #include "NNERuntimeOpenVINOModule.h"
+#include "NNERuntimeOpenVINOSettings.h"
+
+#if WITH_EDITOR
+#include "DerivedDataCacheInterface.h"
+#include "Hash/Blake3.h"
+#include "Interfaces/ITargetPlatform.h"
+
+// Change this to invalidate compiled models stored in the DDC.
+#define OPENVINO_DDC_VERSION TEXT("5E0C1A7B2F4D4E21A3B98C6D0F1E2A47")
+#endif
+
+THIRD_PARTY_INCLUDES_START
+#include "openvino/c/ov_compiled_model.h"
+#include "openvino/c/ov_layout.h"
+#include "openvino/c/ov_prepostprocess.h"
+#include "openvino/c/ov_property.h"
+#include "openvino/c/ov_tensor.h"
+THIRD_PARTY_INCLUDES_END
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Warm-up First Inference Total (ms)"), STAT_OpenVINOWarmUpFirstInference, STATGROUP_NNERuntimeOpenVINO);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Warm-up Steady Inference Total (ms)"), STAT_OpenVINOWarmUpSteadyInference, STATGROUP_NNERuntimeOpenVINO);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Warmed-up Models"), STAT_OpenVINOWarmedUpModels, STATGROUP_NNERuntimeOpenVINO);
+DECLARE_CYCLE_STAT(TEXT("Decompress Model Data"), STAT_OpenVINODecompressModelData, STATGROUP_NNERuntimeOpenVINO);
+
+FOpenVINOModelWeights::FOpenVINOModelWeights(TSharedPtr<UE::NNE::FSharedModelData> InModelData, const FOpenVINOModelView& ModelView)
+	: ModelData(InModelData)
+	, Payload(ModelView.Payload)
+	, DecompressedData(ModelView.DecompressedData)
+{
+}
+
+FOpenVINOSharedModel::FOpenVINOSharedModel(TSharedPtr<UE::NNE::FSharedModelData> InModelData, const FOpenVINOModelView& ModelView, ov_model_t* InModel)
+	: Weights(InModelData ? MakeShared<const FOpenVINOModelWeights>(InModelData, ModelView) : nullptr)
+	, Model(InModel)
+{
+}
+
+// The CPU plugin uses constants in place when they're suitably aligned, the GPU and NPU plugins copy them to the device.
+static bool UsesWeightsInPlace(const FString& DeviceName)
+{
+	return DeviceName.StartsWith(TEXT("CPU"));
+}
+
+FOpenVINOSharedModel::~FOpenVINOSharedModel()
+{
+	if (Model)
+	{
+		ov_model_free(Model);
+	}
+}
+
+FOpenVINOModelDataSource::FOpenVINOModelDataSource(TSharedRef<UE::NNE::FSharedModelData> InModelData, UNNEModelData* InAsset, const FString& InRuntimeName)
+	: ModelData(InModelData)
+	, AssetPath(InAsset)
+	, RuntimeName(InRuntimeName)
+{
+	if (InAsset)
+	{
+		ResolvePayload(*InAsset, InModelData);
+	}
+}
+
+bool FOpenVINOModelDataSource::ResolvePayload(UNNEModelData& Asset, TSharedRef<UE::NNE::FSharedModelData> InModelData)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	TArray<FSection> Sections;
+	const FSection* Reference = ReadSections(InModelData->GetView(), Sections) ? FindSection(Sections, ESectionType::PayloadReference) : nullptr;
+	if (!Reference)
+	{
+		return true;
+	}
+
+	// Held here so the payload outlives the model data of every runtime referring to it.
+	Payload = Asset.GetModelData(Reference->Name);
+	if (!Payload)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("%s has no %s model data to take the shared payload from."), *Asset.GetName(), *Reference->Name);
+		return false;
+	}
+
+	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	if (OVModule)
+	{
+		OVModule->RegisterSharedPayload(Reference->Version, Payload.ToSharedRef());
+	}
+
+	return true;
+}
+
+TSharedPtr<UE::NNE::FSharedModelData> FOpenVINOModelDataSource::Get()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (ModelData)
+	{
+		return ModelData;
+	}
+
+	// Loading can only happen on the game thread, elsewhere the asset must still be loaded.
+	// Off the game thread, the GC is held off so the asset can't be collected while its data is fetched.
+	TOptional<FGCScopeGuard> GCGuard;
+	UNNEModelData* Asset = nullptr;
+	if (IsInGameThread())
+	{
+		Asset = Cast<UNNEModelData>(AssetPath.TryLoad());
+	}
+	else
+	{
+		GCGuard.Emplace();
+		Asset = Cast<UNNEModelData>(AssetPath.ResolveObject());
+		if (!Asset)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Couldn't reload the released model data, %s is unloaded and can't be loaded off the game thread."), *AssetPath.ToString());
+			return {};
+		}
+	}
+
+	if (!Asset)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Couldn't reload the released model data from %s."), *AssetPath.ToString());
+		return {};
+	}
+
+	// Not cached here, it's only needed while compiling. The payload it refers to is, until released again.
+	TSharedPtr<UE::NNE::FSharedModelData> ReloadedData = Asset->GetModelData(RuntimeName);
+	if (!ReloadedData)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("%s has no %s model data to reload."), *AssetPath.ToString(), *RuntimeName);
+		return {};
+	}
+
+	if (!ResolvePayload(*Asset, ReloadedData.ToSharedRef()))
+	{
+		return {};
+	}
+
+	return ReloadedData;
+}
+
+bool FOpenVINOModelDataSource::ReleaseAfterCompile(const FString& DeviceName)
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!Settings || !Settings->bReleaseModelDataAfterCompile)
+	{
+		return false;
+	}
+
+	// CPU compiled models use IR weights read from memory in place, so the model data is only redundant when
+	// they're mapped from staged files instead or run in the daemon. Instances hold it otherwise, releasing saves nothing.
+	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	const bool bMapsWeights = OVModule && (OVModule->MapsWeights() || OVModule->SharesCompiledModels(DeviceName));
+	if (UsesWeightsInPlace(DeviceName) && !bMapsWeights && !ShouldUseInferenceDaemon())
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (!AssetPath.IsValid())
+	{
+		return false;
+	}
+
+	ModelData.Reset();
+	Payload.Reset();
+	return true;
+}
+
+bool FOpenVINOModelDataSource::IsValid() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return ModelData.IsValid() || AssetPath.IsValid();
+}
 
 bool IsFileSupported(const FString& FileType)
 {
@@ -129,153 +312,1671 @@ ENNETensorDataType OpenVINOTypeToNNEType(ov_element_type_e ElementType)
 	case ov_element_type_e::BF16:
 		return ENNETensorDataType::BFloat16;
 	}
-	return ENNETensorDataType::None;
-}
+	return ENNETensorDataType::None;
+}
+
+ov_element_type_e NNETypeToOpenVINOType(ENNETensorDataType DataType)
+{
+	switch (DataType)
+	{
+	case ENNETensorDataType::Boolean:
+		return ov_element_type_e::BOOLEAN;
+	case ENNETensorDataType::Half:
+		return ov_element_type_e::F16;
+	case ENNETensorDataType::Float:
+		return ov_element_type_e::F32;
+	case ENNETensorDataType::Double:
+		return ov_element_type_e::F64;
+	case ENNETensorDataType::Int8:
+		return ov_element_type_e::I8;
+	case ENNETensorDataType::Int16:
+		return ov_element_type_e::I16;
+	case ENNETensorDataType::Int32:
+		return ov_element_type_e::I32;
+	case ENNETensorDataType::Int64:
+		return ov_element_type_e::I64;
+	case ENNETensorDataType::UInt8:
+		return ov_element_type_e::U8;
+	case ENNETensorDataType::UInt16:
+		return ov_element_type_e::U16;
+	case ENNETensorDataType::UInt32:
+		return ov_element_type_e::U32;
+	case ENNETensorDataType::UInt64:
+		return ov_element_type_e::U64;
+	case ENNETensorDataType::BFloat16:
+		return ov_element_type_e::BF16;
+	}
+	return ov_element_type_e::UNDEFINED;
+}
+
+void ReleasePorts(TArray<ov_output_const_port_t*>& Ports)
+{
+	for (ov_output_const_port_t*& Port : Ports)
+	{
+		if (Port)
+		{
+			ov_output_const_port_free(Port);
+		}
+	}
+}
+
+void ReleaseShapes(TArray<ov_shape_t>& Shapes)
+{
+	for (ov_shape_t& Shape : Shapes)
+	{
+		ov_shape_free(&Shape);
+	}
+}
+
+void ReleasePartialShapes(TArray<ov_partial_shape_t>& Shapes)
+{
+	for (ov_partial_shape_t& Shape : Shapes)
+	{
+		ov_partial_shape_free(&Shape);
+	}
+}
+
+void ReleaseTensors(TArray<ov_tensor_t*>& Tensors)
+{
+	for (ov_tensor_t*& Tensor : Tensors)
+	{
+		if (Tensor)
+		{
+			ov_tensor_free(Tensor);
+		}
+	}
+}
+
+FString GetOpenVINOVersion()
+{
+	ov_version_t OVVersion{};
+	if (ov_get_openvino_version(&OVVersion))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get OpenVINO version."));
+		return FString();
+	}
+
+	const FString Version(ANSI_TO_TCHAR(OVVersion.buildNumber));
+	ov_version_free(&OVVersion);
+	return Version;
+}
+
+// Compressed sections are decompressed into one buffer, each at the alignment it would have in the container.
+static bool DecompressSections(TArray<UE::NNERuntimeOpenVINO::ModelFormat::FSection>& Sections, FSharedBuffer& OutBuffer)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	int64 DecompressedSize = 0;
+	for (const FSection& Section : Sections)
+	{
+		if (Section.Flags & SectionFlag_Compressed)
+		{
+			const int64 UncompressedSize = GetUncompressedSize(Section);
+			if (UncompressedSize < 0)
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid compressed model data."));
+				return false;
+			}
+			DecompressedSize = Align(DecompressedSize, PageAlignment) + UncompressedSize;
+		}
+	}
+
+	if (DecompressedSize == 0)
+	{
+		return true;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_OpenVINODecompressModelData);
+
+	uint8* Buffer = (uint8*)FMemory::Malloc(DecompressedSize, PageAlignment);
+	OutBuffer = FSharedBuffer::TakeOwnership(Buffer, DecompressedSize, FMemory::Free);
+
+	int64 Offset = 0;
+	for (FSection& Section : Sections)
+	{
+		if (Section.Flags & SectionFlag_Compressed)
+		{
+			Offset = Align(Offset, PageAlignment);
+			const TArrayView64<uint8> Destination(Buffer + Offset, GetUncompressedSize(Section));
+			if (!DecompressSection(Section, Destination))
+			{
+				OutBuffer.Reset();
+				return false;
+			}
+
+			Section.Flags &= ~SectionFlag_Compressed;
+			Section.Data = Destination;
+			Offset += Destination.Num();
+		}
+	}
+
+	return true;
+}
+
+static bool IsModelSection(const UE::NNERuntimeOpenVINO::ModelFormat::FSection& Section)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+	return Section.Type == ESectionType::Model || Section.Type == ESectionType::Weights || Section.Type == ESectionType::ExternalData;
+}
+
+static void SetModelViews(TConstArrayView<UE::NNERuntimeOpenVINO::ModelFormat::FSection> Sections, FOpenVINOModelView& OutView)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	const FSection* ModelSection = FindSection(Sections, ESectionType::Model);
+	const FSection* WeightsSection = FindSection(Sections, ESectionType::Weights);
+	OutView.FileData = ModelSection ? ModelSection->Data : TConstArrayView64<uint8>();
+	OutView.WeightsData = WeightsSection ? WeightsSection->Data : TConstArrayView64<uint8>();
+	OutView.ExternalData.Empty();
+
+	for (const FSection& Section : Sections)
+	{
+		if (Section.Type == ESectionType::ExternalData)
+		{
+			OutView.ExternalData.Add({ Section.Name, Section.Data });
+		}
+	}
+}
+
+// Hashes are stored as hex in the version of a section. Model sections written before the content hash was stored have an empty version.
+static FBlake3Hash ParseContentHash(const FString& Version)
+{
+	return Version.Len() == 2 * sizeof(FBlake3Hash::ByteArray) ? FBlake3Hash(Version) : FBlake3Hash();
+}
+
+bool ParseModelData(TConstArrayView64<uint8> Data, FOpenVINOModelView& OutView)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	OutView.Sections.Empty();
+	OutView.DecompressedData.Empty();
+	OutView.CompressedModelData = TConstArrayView64<uint8>();
+	OutView.ContentHash = FBlake3Hash();
+	OutView.Payload.Reset();
+	// Runtime versions are bumped with the format, so data cooked before the container is cooked again rather than read.
+	if (!IsContainer(Data))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid model data."));
+		return false;
+	}
+
+	// Only the section table is read here. Compressed sections stay compressed until something needs their content,
+	// which the shared model registry, the DDC and precompiled blobs often make unnecessary.
+	TArray<FSection> Sections;
+	if (!ReadSections(Data, Sections))
+	{
+		return false;
+	}
+
+	// The model and weights live in the payload of another runtime, only the compiled blobs are this runtime's own.
+	if (const FSection* Reference = FindSection(Sections, ESectionType::PayloadReference))
+	{
+		FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+		TSharedPtr<UE::NNE::FSharedModelData> Payload = OVModule ? OVModule->FindSharedPayload(Reference->Version) : nullptr;
+		if (!Payload)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The model data refers to the %s model data, which isn't loaded. Add %s to the target runtimes of the asset."), *Reference->Name, *Reference->Name);
+			return false;
+		}
+
+		if (!ParseModelData(Payload->GetView(), OutView))
+		{
+			return false;
+		}
+
+		OutView.CompiledBlobs.Empty();
+		OutView.Payload = Payload;
+		if (OutView.ContentHash.IsZero())
+		{
+			OutView.ContentHash = ParseContentHash(Reference->Version);
+		}
+	}
+	else
+	{
+		const FSection* ModelSection = FindSection(Sections, ESectionType::Model);
+		if (!ModelSection || ModelSection->Data.IsEmpty())
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid model data."));
+			return false;
+		}
+
+		OutView.ContentHash = ParseContentHash(ModelSection->Version);
+		OutView.bHasWeights = FindSection(Sections, ESectionType::Weights) != nullptr;
+		OutView.CompiledBlobs.Empty();
+
+		const bool bModelCompressed = Sections.ContainsByPredicate([](const FSection& Section)
+		{
+			return IsModelSection(Section) && (Section.Flags & SectionFlag_Compressed);
+		});
+
+		// Model data cooked before the content hash was stored has to be hashed, so there's no point in waiting.
+		if (bModelCompressed)
+		{
+			SetModelViews({}, OutView);
+			OutView.CompressedModelData = Data;
+			if (OutView.ContentHash.IsZero() && !DecompressModelData(OutView))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			SetModelViews(Sections, OutView);
+		}
+	}
+
+	// Compiled blobs include the pre and postprocessing of the asset at cook, if it had any.
+	const FSection* PrePostProcessSection = FindSection(Sections, ESectionType::PrePostProcess);
+	const FBlake3Hash PrePostProcessHash = PrePostProcessSection ? ParseContentHash(PrePostProcessSection->Version) : FBlake3Hash();
+
+	for (const FSection& Section : Sections)
+	{
+		if (Section.Type == ESectionType::CompiledBlob && !Section.Data.IsEmpty())
+		{
+			OutView.CompiledBlobs.Add({ Section.Name, Section.Version, Section.Data, (Section.Flags & SectionFlag_Compressed) != 0, PrePostProcessHash });
+		}
+	}
+
+	OutView.Sections.Append(Sections);
+	return true;
+}
+
+bool DecompressModelData(FOpenVINOModelView& View)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	if (View.CompressedModelData.IsEmpty())
+	{
+		return true;
+	}
+
+	TArray<FSection> Sections;
+	FSharedBuffer DecompressedData;
+	if (!ReadSections(View.CompressedModelData, Sections))
+	{
+		return false;
+	}
+
+	Sections.RemoveAll([](const FSection& Section) { return !IsModelSection(Section); });
+	if (!DecompressSections(Sections, DecompressedData))
+	{
+		return false;
+	}
+
+	SetModelViews(Sections, View);
+	View.DecompressedData.Add(MoveTemp(DecompressedData));
+	View.CompressedModelData = TConstArrayView64<uint8>();
+	return true;
+}
+
+bool DecompressCompiledBlob(const FOpenVINOCompiledBlob& Blob, FSharedBuffer& OutBuffer, TConstArrayView64<uint8>& OutData)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	OutData = Blob.Data;
+	if (!Blob.bCompressed)
+	{
+		return true;
+	}
+
+	TArray<FSection> Sections;
+	FSection& Section = Sections.AddDefaulted_GetRef();
+	Section.Type = ESectionType::CompiledBlob;
+	Section.Flags = SectionFlag_Compressed;
+	Section.Data = Blob.Data;
+	if (!DecompressSections(Sections, OutBuffer))
+	{
+		return false;
+	}
+
+	OutData = Sections[0].Data;
+	return true;
+}
+
+bool IsValidExternalDataLocation(const FString& Location)
+{
+	if (Location.IsEmpty() || !FPaths::IsRelative(Location) || Location.Contains(TEXT(":")))
+	{
+		return false;
+	}
+
+	FString NormalizedLocation = Location;
+	FPaths::NormalizeFilename(NormalizedLocation);
+	return FPaths::CollapseRelativeDirectories(NormalizedLocation) && !NormalizedLocation.StartsWith(TEXT("../")) && NormalizedLocation != TEXT("..");
+}
+
+bool ShouldPrecompileModel(const ITargetPlatform* TargetPlatform)
+{
+#if WITH_EDITOR
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!TargetPlatform || !Settings || !Settings->bPrecompileOnCook)
+	{
+		return false;
+	}
+
+	// Compiled blobs can only be produced for the platform the cooker is running on.
+	return TargetPlatform->IniPlatformName() == ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName());
+#else
+	return false;
+#endif
+}
+
+static bool ShouldCompressModelData(const ITargetPlatform* TargetPlatform, FName& OutFormatName)
+{
+#if WITH_EDITOR
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!TargetPlatform || !Settings || !Settings->bCompressModelData)
+	{
+		return false;
+	}
+
+	OutFormatName = Settings->ModelDataCompressionFormat;
+	if (!FCompression::IsFormatValid(OutFormatName))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Unknown compression format %s, model data is stored uncompressed."), *OutFormatName.ToString());
+		return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+// Runtime whose model data holds the payload the other runtimes refer to.
+static const TCHAR* SharedPayloadRuntimeName = TEXT("NNERuntimeOpenVINOCpu");
+
+static bool ShouldReferenceSharedPayload(const FString& DeviceName, const ITargetPlatform* TargetPlatform)
+{
+#if WITH_EDITOR && defined(OPENVINO_CPU_PLUGIN)
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	return TargetPlatform && Settings && Settings->bShareCookedPayload && DeviceName != TEXT("CPU");
+#else
+	return false;
+#endif
+}
+
+#if WITH_EDITOR
+// IR written by a newer converter may use operations the bundled runtime can't read, so the versions must match.
+// The result is remembered per converter, asking for the version starts a Python interpreter.
+static bool IsOnnxConverterCompatible(const FString& Converter)
+{
+	static FCriticalSection Lock;
+	static TMap<FString, bool> Results;
+
+	FScopeLock ScopeLock(&Lock);
+	if (const bool* Result = Results.Find(Converter))
+	{
+		return *Result;
+	}
+
+	// Build numbers look like 2024.4.0-16579-c3152d32c9c-releases/2024/4, the release is enough.
+	FString RuntimeVersion = GetOpenVINOVersion();
+	RuntimeVersion.Split(TEXT("-"), &RuntimeVersion, nullptr);
+
+	int32 ReturnCode = -1;
+	FString StdOut;
+	FString StdErr;
+	bool bCompatible = false;
+	if (!FPlatformProcess::ExecProcess(*Converter, TEXT("--version"), &ReturnCode, &StdOut, &StdErr) || ReturnCode != 0)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Couldn't run the ONNX converter %s, ONNX models are cooked as ONNX."), *Converter);
+	}
+	else if (RuntimeVersion.IsEmpty() || !StdOut.Contains(RuntimeVersion))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("The ONNX converter %s doesn't match the bundled OpenVINO %s, ONNX models are cooked as ONNX. Converter version: %s"), *Converter, *RuntimeVersion, *StdOut.TrimStartAndEnd());
+	}
+	else
+	{
+		bCompatible = true;
+	}
+
+	Results.Add(Converter, bCompatible);
+	return bCompatible;
+}
+#endif
+
+static bool ShouldConvertOnnxModel(const FString& FileType, const ITargetPlatform* TargetPlatform)
+{
+#if WITH_EDITOR
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	return TargetPlatform && Settings && !Settings->OnnxConverter.IsEmpty() && FileType.Compare(TEXT("onnx"), ESearchCase::IgnoreCase) == 0
+		&& IsOnnxConverterCompatible(Settings->OnnxConverter);
+#else
+	return false;
+#endif
+}
+
+// The C API can't serialize a model, so the conversion goes through OpenVINO's model conversion tool.
+static bool ConvertOnnxModel(TConstArrayView64<uint8> OnnxData, const TMap<FString, TConstArrayView64<uint8>>& ExternalData, TArray64<uint8>& OutFileData, TArray64<uint8>& OutWeightsData)
+{
+#if WITH_EDITOR
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	IFileManager& FileManager = IFileManager::Get();
+
+	const FString Directory(FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("OpenVINO"), TEXT("Convert"), FGuid::NewGuid().ToString()));
+	FileManager.MakeDirectory(*Directory, true);
+	ON_SCOPE_EXIT
+	{
+		FileManager.DeleteDirectory(*Directory, false, true);
+	};
+
+	const FString OnnxFilename(FileManager.ConvertToAbsolutePathForExternalAppForWrite(*FPaths::Combine(Directory, TEXT("Model.onnx"))));
+	const FString ModelFilename(FileManager.ConvertToAbsolutePathForExternalAppForWrite(*FPaths::Combine(Directory, TEXT("Model.xml"))));
+	if (!FFileHelper::SaveArrayToFile(OnnxData, *OnnxFilename))
+	{
+		return false;
+	}
+
+	// The converter reads external data next to the model and folds it into the weights.
+	for (const TPair<FString, TConstArrayView64<uint8>>& Pair : ExternalData)
+	{
+		if (!IsValidExternalDataLocation(Pair.Key) || !FFileHelper::SaveArrayToFile(Pair.Value, *FPaths::Combine(Directory, Pair.Key)))
+		{
+			return false;
+		}
+	}
+
+	// Weights keep their precision, compression to FP16 is a separate setting.
+	const FString Params(FString::Printf(TEXT("\"%s\" --output_model \"%s\" --compress_to_fp16=False"), *OnnxFilename, *ModelFilename));
+	int32 ReturnCode = -1;
+	FString StdOut;
+	FString StdErr;
+	if (!FPlatformProcess::ExecProcess(*Settings->OnnxConverter, *Params, &ReturnCode, &StdOut, &StdErr) || ReturnCode != 0)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Converting the ONNX model to IR with %s failed: %s"), *Settings->OnnxConverter, *StdErr);
+		return false;
+	}
+
+	if (!FFileHelper::LoadFileToArray(OutFileData, *ModelFilename) || !FFileHelper::LoadFileToArray(OutWeightsData, *FPaths::ChangeExtension(ModelFilename, TEXT("bin"))))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("%s didn't produce an IR model."), *Settings->OnnxConverter);
+		return false;
+	}
+
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Converted the ONNX model to IR (%lld bytes of weights)."), OutWeightsData.Num());
+	return true;
+#else
+	return false;
+#endif
+}
+
+#if WITH_EDITOR
+// Per-asset settings list assets, model data only knows the file id of the asset it's created for.
+// That asset is loaded while its model data is created, so a listed asset that isn't loaded can't be it.
+// Nothing is loaded here, which keeps the result the same on every thread and whatever else is in memory.
+static bool IsModelAsset(const TSoftObjectPtr<UNNEModelData>& Model, const FGuid& FileId)
+{
+	const UNNEModelData* Asset = Model.Get();
+	return Asset && Asset->GetFileId() == FileId;
+}
+
+static bool IsModelListed(const TArray<TSoftObjectPtr<UNNEModelData>>& Models, const FGuid& FileId)
+{
+	return Models.ContainsByPredicate([&FileId](const TSoftObjectPtr<UNNEModelData>& Model) { return IsModelAsset(Model, FileId); });
+}
+#endif
+
+// The pre and postprocessing of the asset in the settings, which its instances get unless they set their own.
+static FNNERuntimeOpenVINOInstanceOptions GetAssetPrePostProcessing(const FGuid& FileId)
+{
+	FNNERuntimeOpenVINOInstanceOptions Options;
+#if WITH_EDITOR
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	const FNNERuntimeOpenVINOModelPreProcess* PreProcess = Settings ? Settings->PreProcessing.FindByPredicate([&FileId](const FNNERuntimeOpenVINOModelPreProcess& Entry)
+	{
+		return IsModelAsset(Entry.Model, FileId);
+	}) : nullptr;
+
+	if (PreProcess)
+	{
+		Options.PreProcessing = PreProcess->Inputs;
+		Options.PostProcessing = PreProcess->Outputs;
+	}
+#endif
+	return Options;
+}
+
+#if WITH_EDITOR
+// Reads the calibration input files of a model, one per input. Empty if the model has none.
+static TArray<TArray64<uint8>> LoadCalibrationInputs(const FGuid& FileId)
+{
+	TArray<TArray64<uint8>> Inputs;
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!Settings)
+	{
+		return Inputs;
+	}
+
+	for (const TPair<TSoftObjectPtr<UNNEModelData>, FString>& Pair : Settings->Fp16CalibrationInputs)
+	{
+		if (!IsModelAsset(Pair.Key, FileId))
+		{
+			continue;
+		}
+
+		const FString Directory = FPaths::IsRelative(Pair.Value) ? FPaths::Combine(FPaths::ProjectDir(), Pair.Value) : Pair.Value;
+		for (int32 i = 0; ; ++i)
+		{
+			const FString Filename = FPaths::Combine(Directory, FString::Printf(TEXT("%d.bin"), i));
+			if (!IFileManager::Get().FileExists(*Filename) || !FFileHelper::LoadFileToArray(Inputs.AddDefaulted_GetRef(), *Filename))
+			{
+				Inputs.SetNum(i);
+				break;
+			}
+		}
+
+		if (Inputs.IsEmpty())
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("No calibration input found in %s, expected 0.bin, 1.bin, ..."), *Directory);
+		}
+		break;
+	}
+
+	return Inputs;
+}
+#endif
+
+static bool ShouldCompressModelToFp16(const FGuid& FileId, const ITargetPlatform* TargetPlatform)
+{
+#if WITH_EDITOR
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	return TargetPlatform && Settings && IsModelListed(Settings->Fp16Models, FileId);
+#else
+	return false;
+#endif
+}
+
+// Replaces the model and weights sections of an IR model with their FP16 version.
+static void CompressModelToFp16(TArray<UE::NNERuntimeOpenVINO::ModelFormat::FSection>& Sections, const FGuid& FileId, TArray64<uint8>& OutFileData, TArray64<uint8>& OutWeightsData)
+{
+#if WITH_EDITOR
+	using namespace UE::NNERuntimeOpenVINO;
+
+	FOpenVINOModelView Reference;
+	Reference.bHasWeights = true;
+	for (const ModelFormat::FSection& Section : Sections)
+	{
+		Reference.FileData = Section.Type == ModelFormat::ESectionType::Model ? Section.Data : Reference.FileData;
+		Reference.WeightsData = Section.Type == ModelFormat::ESectionType::Weights ? Section.Data : Reference.WeightsData;
+	}
+
+	IR::FFp16CompressionStats Stats;
+	if (Reference.FileData.IsEmpty() || !IR::CompressWeightsToFp16(Reference.FileData, Reference.WeightsData, OutFileData, OutWeightsData, Stats))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Couldn't compress the model to FP16, cooking it unchanged."));
+		return;
+	}
+
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Compressed %d constants to FP16, weights %.2f MB -> %.2f MB (%.0f%%)."), Stats.NumCompressedConstants,
+		Stats.OriginalWeightsBytes / (1024.0 * 1024.0), Stats.CompressedWeightsBytes / (1024.0 * 1024.0), Stats.OriginalWeightsBytes > 0 ? 100.0 * Stats.CompressedWeightsBytes / Stats.OriginalWeightsBytes : 100.0);
+
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	if (Settings && Settings->bMeasureFp16Deviation && OVModule)
+	{
+		FOpenVINOModelView Compressed = Reference;
+		Compressed.FileData = OutFileData;
+		Compressed.WeightsData = OutWeightsData;
+
+		const TArray<TArray64<uint8>> CalibrationInputs = LoadCalibrationInputs(FileId);
+
+		double MaxAbsDeviation = 0.0;
+		double MeanAbsDeviation = 0.0;
+		if (IR::MeasureOutputDeviation(OVModule->OpenVINOInstance(), Reference, Compressed, CalibrationInputs, MaxAbsDeviation, MeanAbsDeviation))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("FP16 output deviation on %s input: max %g, mean %g."), CalibrationInputs.IsEmpty() ? TEXT("random") : TEXT("calibration"), MaxAbsDeviation, MeanAbsDeviation);
+		}
+	}
+
+	for (ModelFormat::FSection& Section : Sections)
+	{
+		Section.Data = Section.Type == ModelFormat::ESectionType::Model ? TConstArrayView64<uint8>(OutFileData) : Section.Data;
+		Section.Data = Section.Type == ModelFormat::ESectionType::Weights ? TConstArrayView64<uint8>(OutWeightsData) : Section.Data;
+	}
+#endif
+}
+
+FString GetModelDataIdentifierSuffix(const FString& FileType, const FGuid& FileId, const FString& DeviceName, const ITargetPlatform* TargetPlatform)
+{
+	// Precompiled blobs are tied to the OpenVINO build that produced them, and include the asset's pre and postprocessing.
+	FString Suffix;
+	if (ShouldPrecompileModel(TargetPlatform))
+	{
+		Suffix = TEXT("-") + GetOpenVINOVersion();
+
+		const FBlake3Hash PrePostProcessHash = HashPrePostProcessing(GetAssetPrePostProcessing(FileId));
+		if (!PrePostProcessHash.IsZero())
+		{
+			Suffix += TEXT("-PP") + LexToString(PrePostProcessHash).Left(16);
+		}
+	}
+
+	if (ShouldReferenceSharedPayload(DeviceName, TargetPlatform))
+	{
+		Suffix += TEXT("-Shared");
+	}
+
+	// Only set when the conversion is expected to succeed. If it fails anyway, no model data is created under this identifier.
+	if (ShouldConvertOnnxModel(FileType, TargetPlatform))
+	{
+		Suffix += TEXT("-IR");
+	}
+
+	if (ShouldCompressModelToFp16(FileId, TargetPlatform))
+	{
+		Suffix += TEXT("-FP16");
+	}
+
+	FName CompressionFormat;
+	if (ShouldCompressModelData(TargetPlatform, CompressionFormat))
+	{
+		Suffix += TEXT("-") + CompressionFormat.ToString();
+	}
+
+	return Suffix;
+}
+
+static bool PrecompileModel(TConstArrayView64<uint8> Data, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing, TArray64<uint8>& OutBlob)
+{
+	FOpenVINOModelView ModelView;
+	if (!ParseModelData(Data, ModelView) || !DecompressModelData(ModelView))
+	{
+		return false;
+	}
+
+	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	if (!OVModule)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Couldn't find NNERuntimeOpenVINO module."));
+		return false;
+	}
+
+	ov_core_t& OVCore = OVModule->OpenVINOInstance();
+	if (!SupportsDevice(OVCore, DeviceName))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Skipping [%s] precompilation, device not found on this machine."), *DeviceName);
+		return false;
+	}
+
+	ov_model_t* Model = nullptr;
+	if (!ReadModel(OVCore, ModelView, Model))
+	{
+		return false;
+	}
+
+	// The model was read for this alone, so the pre and postprocessing can edit it.
+	if (!ApplyPrePostProcessing(Model, PrePostProcessing))
+	{
+		ov_model_free(Model);
+		return false;
+	}
+
+	ov_compiled_model_t* CompiledModel = nullptr;
+	ov_status_e CompileResult = ov_core_compile_model(&OVCore, Model, TCHAR_TO_ANSI(*DeviceName), 0, &CompiledModel);
+	ov_model_free(Model);
+
+	if (CompileResult)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to precompile the model for [%s]."), *DeviceName);
+		return false;
+	}
+
+	const bool bExported = ExportCompiledModel(CompiledModel, OutBlob);
+	ov_compiled_model_free(CompiledModel);
+	return bExported;
+}
+
+TSharedPtr<UE::NNE::FSharedModelData> CreateOpenVINOModelData(const FString& FileType, TConstArrayView64<uint8> FileData, const TMap<FString, TConstArrayView64<uint8>>& AdditionalFileData, const FGuid& FileId, const FString& DeviceName, const ITargetPlatform* TargetPlatform)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	const bool bHasWeights = FileType.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0;
+
+	TArray<FSection> Sections;
+	TArray64<uint8> ConvertedFileData;
+	TArray64<uint8> ConvertedWeightsData;
+	FSection ModelSection;
+	ModelSection.Type = ESectionType::Model;
+	ModelSection.Name = FileType.ToLower();
+	ModelSection.Data = FileData;
+
+	// IR data is imported by the editor factory as the XML and BIN sizes followed by both files.
+	if (bHasWeights)
+	{
+		FMemoryReaderView MemoryReader(FileData);
+		int64 FileDataSize = 0;
+		int64 WeightsDataSize = 0;
+		MemoryReader << FileDataSize;
+		MemoryReader << WeightsDataSize;
+
+		const int64 FileDataOffset = MemoryReader.Tell();
+		if (MemoryReader.IsError() || FileDataSize <= 0 || WeightsDataSize < 0 || FileDataOffset + FileDataSize + WeightsDataSize > FileData.Num())
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid IR model data."));
+			return {};
+		}
+
+		ModelSection.Data = FileData.Slice(FileDataOffset, FileDataSize);
+
+		FSection WeightsSection;
+		WeightsSection.Type = ESectionType::Weights;
+		WeightsSection.Data = FileData.Slice(FileDataOffset + FileDataSize, WeightsDataSize);
+		Sections.Add(ModelSection);
+		Sections.Add(WeightsSection);
+	}
+	else if (ShouldConvertOnnxModel(FileType, TargetPlatform))
+	{
+		// The identifier says IR, cooking the ONNX model instead would cache it under the wrong identifier.
+		if (!ConvertOnnxModel(FileData, AdditionalFileData, ConvertedFileData, ConvertedWeightsData))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to convert the ONNX model to IR. Fix the converter or clear OnnxConverter to cook it as ONNX."));
+			return {};
+		}
+
+		ModelSection.Name = TEXT("xml");
+		ModelSection.Data = ConvertedFileData;
+
+		FSection WeightsSection;
+		WeightsSection.Type = ESectionType::Weights;
+		WeightsSection.Data = ConvertedWeightsData;
+		Sections.Add(ModelSection);
+		Sections.Add(WeightsSection);
+	}
+	else
+	{
+		Sections.Add(ModelSection);
+
+		// ONNX models over 2 GB keep their initializers in files next to the model, imported as additional file data.
+		for (const TPair<FString, TConstArrayView64<uint8>>& Pair : AdditionalFileData)
+		{
+			if (!IsValidExternalDataLocation(Pair.Key))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid external data location %s."), *Pair.Key);
+				return {};
+			}
+
+			FSection ExternalDataSection;
+			ExternalDataSection.Type = ESectionType::ExternalData;
+			ExternalDataSection.Name = Pair.Key;
+			ExternalDataSection.Data = Pair.Value;
+			Sections.Add(ExternalDataSection);
+		}
+	}
+
+	TArray64<uint8> Fp16FileData;
+	TArray64<uint8> Fp16WeightsData;
+	if (FindSection(Sections, ESectionType::Weights) && ShouldCompressModelToFp16(FileId, TargetPlatform))
+	{
+		CompressModelToFp16(Sections, FileId, Fp16FileData, Fp16WeightsData);
+	}
+
+	FSharedBuffer ContainerData = WriteSections(Sections);
+
+	TArray64<uint8> CompiledBlob;
+	const FNNERuntimeOpenVINOInstanceOptions PrePostProcessing = GetAssetPrePostProcessing(FileId);
+	if (ShouldPrecompileModel(TargetPlatform) && PrecompileModel(MakeView(ContainerData), DeviceName, PrePostProcessing, CompiledBlob))
+	{
+		FSection BlobSection;
+		BlobSection.Type = ESectionType::CompiledBlob;
+		BlobSection.Name = DeviceName;
+		BlobSection.Version = GetOpenVINOVersion();
+		BlobSection.Data = CompiledBlob;
+		Sections.Add(BlobSection);
+
+		const FBlake3Hash PrePostProcessHash = HashPrePostProcessing(PrePostProcessing);
+		if (!PrePostProcessHash.IsZero())
+		{
+			FSection PrePostProcessSection;
+			PrePostProcessSection.Type = ESectionType::PrePostProcess;
+			PrePostProcessSection.Version = LexToString(PrePostProcessHash);
+			Sections.Add(PrePostProcessSection);
+		}
+
+		ContainerData = WriteSections(Sections);
+	}
+
+	// The content hash is stored with the model, so loading can look up shared models, the DDC and the shared store
+	// without hashing or decompressing it. Only the CPU runtime stores the model and weights, the others refer to its payload by content hash.
+	FOpenVINOModelView ModelView;
+	if (ParseModelData(MakeView(ContainerData), ModelView))
+	{
+		const FString ContentHash = LexToString(FNNERuntimeOpenVINO::HashModel(ModelView));
+		if (ShouldReferenceSharedPayload(DeviceName, TargetPlatform))
+		{
+			FSection ReferenceSection;
+			ReferenceSection.Type = ESectionType::PayloadReference;
+			ReferenceSection.Name = SharedPayloadRuntimeName;
+			ReferenceSection.Version = ContentHash;
+
+			Sections.RemoveAll([](const FSection& Section) { return Section.Type == ESectionType::Model || Section.Type == ESectionType::Weights || Section.Type == ESectionType::ExternalData; });
+			Sections.Insert(ReferenceSection, 0);
+		}
+		else if (FSection* ModelSection = Sections.FindByPredicate([](const FSection& Section) { return Section.Type == ESectionType::Model; }))
+		{
+			ModelSection->Version = ContentHash;
+		}
+		ContainerData = WriteSections(Sections);
+	}
+
+	// Compression is applied last so precompilation reads the plain data. The payloads must outlive the write.
+	FName CompressionFormat;
+	if (ShouldCompressModelData(TargetPlatform, CompressionFormat))
+	{
+		TArray<TArray64<uint8>> CompressedPayloads;
+		bool bCompressed = false;
+		for (FSection& Section : Sections)
+		{
+			bCompressed |= CompressSection(Section, CompressionFormat, CompressedPayloads.AddDefaulted_GetRef());
+		}
+
+		if (bCompressed)
+		{
+			ContainerData = WriteSections(Sections);
+		}
+	}
+
+	// Section offsets are aligned relative to the start of the data, and the container is page aligned itself.
+	TSharedPtr<UE::NNE::FSharedModelData> SharedData(MakeShared<UE::NNE::FSharedModelData>(ContainerData, (uint32)PageAlignment));
+	return SharedData;
+}
+
+bool ReadModel(ov_core_t& OVCore, const FOpenVINOModelView& ModelView, ov_model_t*& Model, const FBlake3Hash* ContentHash)
+{
+	// OpenVINO resolves external data relative to the model file, a model read from memory has none.
+	if (!ModelView.ExternalData.IsEmpty())
+	{
+		FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+		if (!OVModule || !OVModule->ReadMappedModel(ModelView, ContentHash ? *ContentHash : FNNERuntimeOpenVINO::HashModel(ModelView), Model))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to read the model with external data."));
+			return false;
+		}
+
+		return true;
+	}
+
+	ov_status_e LoadResult = ov_status_e::OK;
+	if (!ModelView.bHasWeights)
+	{
+		LoadResult = ov_core_read_model_from_memory_buffer(&OVCore, (const char*)ModelView.FileData.GetData(), ModelView.FileData.Num(), NULL, &Model);
+	}
+	else 
+	{
+		// In the case of IR models, we must create a temporary Tensor as input.
+		// The data for the tensor comes from the asset so there is no additional allocation inside of OpenVINO.
+		ov_shape_t TempShape{};
+		int64_t Dims[1] = { (int64_t)ModelView.WeightsData.NumBytes() };
+		if (ov_shape_create(1, Dims, &TempShape))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to setup the IR model."));
+			return false;
+		}
+
+		ov_tensor_t* TempTensor = NULL;
+		if (ov_tensor_create_from_host_ptr(U8, TempShape, (void*)ModelView.WeightsData.GetData(), &TempTensor))
+		{
+			ov_shape_free(&TempShape);
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to setup the IR model."));
+			return false;
+		}
+
+		LoadResult = ov_core_read_model_from_memory_buffer(&OVCore, (const char*)ModelView.FileData.GetData(), ModelView.FileData.Num(), TempTensor, &Model);
+		
+		ov_tensor_free(TempTensor);
+		ov_shape_free(&TempShape);
+	}
+
+	if (LoadResult)
+	{
+		if (Model)
+		{
+			ov_model_free(Model);
+			Model = nullptr;
+		}
+
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to read the model."));
+		return false;
+	}
+
+	return true;
+}
+
+bool ExportCompiledModel(const ov_compiled_model_t* CompiledModel, TArray64<uint8>& OutBlob)
+{
+	// The C API only exports to a file, so go through a temporary one.
+	const FString TempFilename(FPaths::CreateTempFilename(*FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OpenVINO")), TEXT("Export"), TEXT(".blob")));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(TempFilename), true);
+
+	const FString ExportPath(IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*TempFilename));
+	if (ov_compiled_model_export_model(CompiledModel, TCHAR_TO_UTF8(*ExportPath)))
+	{
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to export the compiled model."));
+		return false;
+	}
+
+	const bool bLoaded = FFileHelper::LoadFileToArray(OutBlob, *TempFilename);
+	IFileManager::Get().Delete(*TempFilename, false, false, true);
+
+	if (!bLoaded || OutBlob.IsEmpty())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to load the exported model."));
+		return false;
+	}
+
+	return true;
+}
+
+#if WITH_EDITOR
+static FString GetDeviceProperty(ov_core_t& OVCore, const FString& DeviceName, const char* PropertyKey)
+{
+	char* PropertyValue = nullptr;
+	if (ov_core_get_property(&OVCore, TCHAR_TO_ANSI(*DeviceName), PropertyKey, &PropertyValue))
+	{
+		return FString();
+	}
+
+	const FString Value(ANSI_TO_TCHAR(PropertyValue));
+	ov_free(PropertyValue);
+	return Value;
+}
+
+static FString GetCompiledModelCacheKey(ov_core_t& OVCore, const FBlake3Hash& ContentHash, const FString& DeviceName)
+{
+	// The blob depends on the model, the exact device, the OpenVINO build and the properties used to compile it.
+	const FString CompileProperties = FString::Printf(TEXT("%s_%s"),
+		*GetDeviceProperty(OVCore, DeviceName, ov_property_key_hint_performance_mode),
+		*GetDeviceProperty(OVCore, DeviceName, ov_property_key_hint_inference_precision));
+
+	const FString KeySuffix = FString::Printf(TEXT("%s_%s_%s_%s_%s"),
+		*LexToString(ContentHash),
+		*DeviceName,
+		*GetDeviceProperty(OVCore, DeviceName, ov_property_key_device_full_name),
+		*GetOpenVINOVersion(),
+		*CompileProperties);
+
+	return FDerivedDataCacheInterface::BuildCacheKey(TEXT("NNEOPENVINO"), OPENVINO_DDC_VERSION, *FDerivedDataCacheInterface::SanitizeCacheKey(*KeySuffix));
+}
+#endif
+
+// Runs inferences with zero inputs so kernels are JIT compiled, the compiled weights are paged in and scratch memory
+// is allocated before the first real call. The request is kept for the instance's inferences.
+static void WarmUpCompiledModel(ov_compiled_model_t* CompiledModel, ov_infer_request_t*& InferRequest, const FString& DeviceName, int32 NumInferences)
+{
+	size_t InputSize = 0;
+	if (ov_compiled_model_inputs_size(CompiledModel, &InputSize))
+	{
+		return;
+	}
+
+	if (!InferRequest && ov_compiled_model_create_infer_request(CompiledModel, &InferRequest))
+	{
+		InferRequest = nullptr;
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to create the warm-up inference request."));
+		return;
+	}
+
+	TArray<ov_tensor_t*> InputTensors;
+	bool bInputsReady = true;
+	for (size_t i = 0; i < InputSize && bInputsReady; ++i)
+	{
+		bInputsReady = false;
+
+		ov_output_const_port_t* InputPort = nullptr;
+		if (ov_compiled_model_input_by_index(CompiledModel, i, &InputPort))
+		{
+			break;
+		}
+
+		// Dynamic inputs have no shape to fill, the model will warm up on its first real inference instead.
+		ov_shape_t InputShape{};
+		ov_element_type_e InputType{};
+		const bool bStatic = !ov_const_port_get_shape(InputPort, &InputShape) && !ov_port_get_element_type(InputPort, &InputType);
+		ov_output_const_port_free(InputPort);
+
+		if (!bStatic)
+		{
+			ov_shape_free(&InputShape);
+			break;
+		}
+
+		ov_tensor_t*& InputTensor = InputTensors.AddZeroed_GetRef();
+		const bool bCreated = !ov_tensor_create(InputType, InputShape, &InputTensor);
+		ov_shape_free(&InputShape);
+
+		void* TensorData = nullptr;
+		size_t ByteSize = 0;
+		if (!bCreated || ov_tensor_data(InputTensor, &TensorData) || ov_tensor_get_byte_size(InputTensor, &ByteSize)
+			|| ov_infer_request_set_input_tensor_by_index(InferRequest, i, InputTensor))
+		{
+			break;
+		}
+
+		FMemory::Memzero(TensorData, ByteSize);
+		bInputsReady = true;
+	}
+
+	if (!bInputsReady)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Log, TEXT("Skipping warm-up on [%s], the model has dynamic inputs."), *DeviceName);
+		ReleaseTensors(InputTensors);
+		return;
+	}
+
+	double FirstMs = 0.0;
+	double SteadyMs = 0.0;
+	int32 NumSteady = 0;
+	for (int32 Run = 0; Run < NumInferences; ++Run)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		if (ov_infer_request_infer(InferRequest))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Warm-up inference failed on [%s]."), *DeviceName);
+			break;
+		}
+
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		if (Run == 0)
+		{
+			FirstMs = ElapsedMs;
+		}
+		else
+		{
+			SteadyMs += ElapsedMs;
+			NumSteady++;
+		}
+	}
+
+	ReleaseTensors(InputTensors);
+
+	// Average over the inferences that actually ran, a failed one ends the warm-up early.
+	SteadyMs = NumSteady > 0 ? SteadyMs / NumSteady : 0.0;
+
+	INC_FLOAT_STAT_BY(STAT_OpenVINOWarmUpFirstInference, FirstMs);
+	INC_FLOAT_STAT_BY(STAT_OpenVINOWarmUpSteadyInference, SteadyMs);
+	INC_DWORD_STAT(STAT_OpenVINOWarmedUpModels);
+
+	UE_LOG(LogNNERuntimeOpenVINO, Log, TEXT("Warmed up [%s] model: first inference %.2f ms, steady %.2f ms."), *DeviceName, FirstMs, SteadyMs);
+}
+
+static ov_color_format_e GetColorFormat(ENNERuntimeOpenVINOColorFormat ColorFormat)
+{
+	switch (ColorFormat)
+	{
+	case ENNERuntimeOpenVINOColorFormat::RGB:
+		return ov_color_format_e::RGB;
+	case ENNERuntimeOpenVINOColorFormat::BGR:
+		return ov_color_format_e::BGR;
+	case ENNERuntimeOpenVINOColorFormat::RGBX:
+		return ov_color_format_e::RGBX;
+	case ENNERuntimeOpenVINOColorFormat::BGRX:
+		return ov_color_format_e::BGRX;
+	case ENNERuntimeOpenVINOColorFormat::Gray:
+		return ov_color_format_e::GRAY;
+	}
+	return ov_color_format_e::UNDEFINE;
+}
+
+// Steps are added in the order they're applied: color conversion on the caller's data, conversion to FP32 if
+// normalizing, resize, then normalization.
+static bool ConfigureInputPreProcess(ov_preprocess_prepostprocessor_t* PrePostProcessor, const FNNERuntimeOpenVINOInputPreProcess& PreProcess)
+{
+	ov_preprocess_input_info_t* InputInfo = nullptr;
+	ov_preprocess_input_tensor_info_t* TensorInfo = nullptr;
+	ov_preprocess_input_model_info_t* ModelInfo = nullptr;
+	ov_preprocess_preprocess_steps_t* Steps = nullptr;
+	TArray<ov_layout_t*> Layouts;
+	ON_SCOPE_EXIT
+	{
+		for (ov_layout_t* Layout : Layouts)
+		{
+			ov_layout_free(Layout);
+		}
+		if (Steps)
+		{
+			ov_preprocess_preprocess_steps_free(Steps);
+		}
+		if (ModelInfo)
+		{
+			ov_preprocess_input_model_info_free(ModelInfo);
+		}
+		if (TensorInfo)
+		{
+			ov_preprocess_input_tensor_info_free(TensorInfo);
+		}
+		if (InputInfo)
+		{
+			ov_preprocess_input_info_free(InputInfo);
+		}
+	};
+
+	const ov_status_e InfoResult = PreProcess.Input.IsEmpty()
+		? ov_preprocess_prepostprocessor_get_input_info(PrePostProcessor, &InputInfo)
+		: ov_preprocess_prepostprocessor_get_input_info_by_name(PrePostProcessor, TCHAR_TO_UTF8(*PreProcess.Input), &InputInfo);
+	if (InfoResult || ov_preprocess_input_info_get_tensor_info(InputInfo, &TensorInfo) || ov_preprocess_input_info_get_model_info(InputInfo, &ModelInfo)
+		|| ov_preprocess_input_info_get_preprocess_steps(InputInfo, &Steps))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The model has no input %s to preprocess."), *PreProcess.Input);
+		return false;
+	}
+
+	bool bValid = true;
+	if (PreProcess.ElementType != ENNETensorDataType::None)
+	{
+		bValid &= !ov_preprocess_input_tensor_info_set_element_type(TensorInfo, NNETypeToOpenVINOType(PreProcess.ElementType));
+	}
+
+	if (!PreProcess.TensorLayout.IsEmpty())
+	{
+		ov_layout_t*& Layout = Layouts.AddZeroed_GetRef();
+		bValid &= !ov_layout_create(TCHAR_TO_ANSI(*PreProcess.TensorLayout), &Layout) && !ov_preprocess_input_tensor_info_set_layout(TensorInfo, Layout);
+	}
+
+	if (!PreProcess.ModelLayout.IsEmpty())
+	{
+		ov_layout_t*& Layout = Layouts.AddZeroed_GetRef();
+		bValid &= !ov_layout_create(TCHAR_TO_ANSI(*PreProcess.ModelLayout), &Layout) && !ov_preprocess_input_model_info_set_layout(ModelInfo, Layout);
+	}
+
+	if (PreProcess.ColorFormat != ENNERuntimeOpenVINOColorFormat::None)
+	{
+		bValid &= !ov_preprocess_input_tensor_info_set_color_format(TensorInfo, GetColorFormat(PreProcess.ColorFormat));
+	}
+
+	const bool bResize = PreProcess.Width > 0 && PreProcess.Height > 0;
+	if (bResize)
+	{
+		bValid &= !ov_preprocess_input_tensor_info_set_spatial_static_shape(TensorInfo, PreProcess.Height, PreProcess.Width);
+	}
+
+	if (PreProcess.ColorFormat != ENNERuntimeOpenVINOColorFormat::None && PreProcess.ModelColorFormat != ENNERuntimeOpenVINOColorFormat::None)
+	{
+		bValid &= !ov_preprocess_preprocess_steps_convert_color(Steps, GetColorFormat(PreProcess.ModelColorFormat));
+	}
+
+	// Normalizing integer data would truncate it, and so would resizing it before normalization.
+	if (!PreProcess.Mean.IsEmpty() || !PreProcess.Scale.IsEmpty())
+	{
+		bValid &= !ov_preprocess_preprocess_steps_convert_element_type(Steps, ov_element_type_e::F32);
+	}
+
+	if (bResize)
+	{
+		bValid &= !ov_preprocess_preprocess_steps_resize(Steps, ov_preprocess_resize_algorithm_e::RESIZE_LINEAR);
+	}
+
+	if (PreProcess.Mean.Num() == 1)
+	{
+		bValid &= !ov_preprocess_preprocess_steps_mean(Steps, PreProcess.Mean[0]);
+	}
+	else if (PreProcess.Mean.Num() > 1)
+	{
+		bValid &= !ov_preprocess_preprocess_steps_mean_multi_channels(Steps, PreProcess.Mean.GetData(), PreProcess.Mean.Num());
+	}
+
+	if (PreProcess.Scale.Num() == 1)
+	{
+		bValid &= !ov_preprocess_preprocess_steps_scale(Steps, PreProcess.Scale[0]);
+	}
+	else if (PreProcess.Scale.Num() > 1)
+	{
+		bValid &= !ov_preprocess_preprocess_steps_scale_multi_channels(Steps, PreProcess.Scale.GetData(), PreProcess.Scale.Num());
+	}
+
+	if (!bValid)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid preprocessing for input %s."), *PreProcess.Input);
+	}
+
+	return bValid;
+}
+
+static bool ConfigureOutputPostProcess(ov_preprocess_prepostprocessor_t* PrePostProcessor, const FNNERuntimeOpenVINOOutputPostProcess& PostProcess)
+{
+	ov_preprocess_output_info_t* OutputInfo = nullptr;
+	ov_preprocess_output_tensor_info_t* TensorInfo = nullptr;
+	ON_SCOPE_EXIT
+	{
+		if (TensorInfo)
+		{
+			ov_preprocess_output_tensor_info_free(TensorInfo);
+		}
+		if (OutputInfo)
+		{
+			ov_preprocess_output_info_free(OutputInfo);
+		}
+	};
+
+	const ov_status_e InfoResult = PostProcess.Output.IsEmpty()
+		? ov_preprocess_prepostprocessor_get_output_info(PrePostProcessor, &OutputInfo)
+		: ov_preprocess_prepostprocessor_get_output_info_by_name(PrePostProcessor, TCHAR_TO_UTF8(*PostProcess.Output), &OutputInfo);
+	if (InfoResult || ov_preprocess_output_info_get_tensor_info(OutputInfo, &TensorInfo))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The model has no output %s to postprocess."), *PostProcess.Output);
+		return false;
+	}
+
+	if (PostProcess.ElementType != ENNETensorDataType::None && ov_preprocess_output_set_element_type(TensorInfo, NNETypeToOpenVINOType(PostProcess.ElementType)))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid element type for output %s."), *PostProcess.Output);
+		return false;
+	}
+
+	return true;
+}
+
+bool ApplyPrePostProcessing(ov_model_t*& Model, const FNNERuntimeOpenVINOInstanceOptions& Options)
+{
+	if (Options.PreProcessing.IsEmpty() && Options.PostProcessing.IsEmpty())
+	{
+		return true;
+	}
+
+	ov_preprocess_prepostprocessor_t* PrePostProcessor = nullptr;
+	if (ov_preprocess_prepostprocessor_create(Model, &PrePostProcessor))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to create the model pre and postprocessing."));
+		return false;
+	}
+
+	ON_SCOPE_EXIT
+	{
+		ov_preprocess_prepostprocessor_free(PrePostProcessor);
+	};
+
+	for (const FNNERuntimeOpenVINOInputPreProcess& PreProcess : Options.PreProcessing)
+	{
+		if (!ConfigureInputPreProcess(PrePostProcessor, PreProcess))
+		{
+			return false;
+		}
+	}
+
+	for (const FNNERuntimeOpenVINOOutputPostProcess& PostProcess : Options.PostProcessing)
+	{
+		if (!ConfigureOutputPostProcess(PrePostProcessor, PostProcess))
+		{
+			return false;
+		}
+	}
+
+	ov_model_t* ProcessedModel = nullptr;
+	if (ov_preprocess_prepostprocessor_build(PrePostProcessor, &ProcessedModel))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to build the model pre and postprocessing."));
+		return false;
+	}
+
+	ov_model_free(Model);
+	Model = ProcessedModel;
+	return true;
+}
+
+// Constant inputs and output pruning compile a private variant of the model, which nothing precompiled or shared matches.
+static bool CompileModelVariant(ov_core_t& OVCore, TSharedRef<UE::NNE::FSharedModelData> ModelData, const FOpenVINOModelView& ModelView, const FNNERuntimeOpenVINOInstanceOptions& Options, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, const FString& DeviceName)
+{
+	using namespace UE::NNERuntimeOpenVINO;
+
+	// OpenVINO parses the XML when reading the model, only the weights must outlive the read.
+	TArray64<uint8> FileData;
+	TSharedPtr<UE::NNE::FSharedModelData> FrozenWeightsData;
+	FOpenVINOModelView VariantView = ModelView;
+
+	if (!Options.ConstantInputs.IsEmpty() || !Options.Outputs.IsEmpty())
+	{
+		// Only IR can be edited without a serializer, ONNX models can be converted to IR when cooking.
+		if (!ModelView.bHasWeights)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Constant inputs and outputs can only be set for IR models, set OnnxConverter to cook ONNX models as IR."));
+			return false;
+		}
+
+		FileData.Append(ModelView.FileData.GetData(), ModelView.FileData.Num());
+	}
+
+	// IR has a single weights buffer, so frozen values can only be added to a copy of all the weights.
+	if (!Options.ConstantInputs.IsEmpty())
+	{
+		TArray64<uint8> FrozenFileData;
+		TArray64<uint8> FrozenWeightsData;
+		if (!IR::FreezeInputs(FileData, ModelView.WeightsData, Options.ConstantInputs, FrozenFileData, FrozenWeightsData))
+		{
+			return false;
+		}
+
+		FileData = MoveTemp(FrozenFileData);
+		FrozenWeightsData = MakeShared<UE::NNE::FSharedModelData>(MakeSharedBufferFromArray(MoveTemp(FrozenWeightsData)), (uint32)ModelFormat::PageAlignment);
+		VariantView.WeightsData = FrozenWeightsData->GetView();
+	}
+
+	if (!Options.Outputs.IsEmpty())
+	{
+		TArray64<uint8> PrunedFileData;
+		if (!IR::PruneOutputs(FileData, Options.Outputs, PrunedFileData))
+		{
+			return false;
+		}
+
+		FileData = MoveTemp(PrunedFileData);
+	}
+
+	if (!FileData.IsEmpty())
+	{
+		VariantView.FileData = FileData;
+	}
+
+	// Read privately rather than through the module, the pre and postprocessing edit the model.
+	ov_model_t* Model = nullptr;
+	if (!ReadModel(OVCore, VariantView, Model))
+	{
+		return false;
+	}
+
+	if (!ApplyPrePostProcessing(Model, Options))
+	{
+		ov_model_free(Model);
+		return false;
+	}
+
+	if (ov_core_compile_model(&OVCore, Model, TCHAR_TO_ANSI(*DeviceName), 0, &CompiledModel))
+	{
+		CompiledModel = nullptr;
+		ov_model_free(Model);
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to compile the model."));
+		return false;
+	}
+
+	ov_model_free(Model);
+
+	// The compiled model may use the weights it was read with in place, the frozen copy included, which is then
+	// only held by this instance and counted in its footprint.
+	if (UsesWeightsInPlace(DeviceName))
+	{
+		if (FrozenWeightsData)
+		{
+			TSharedRef<FOpenVINOModelWeights> FrozenWeights = MakeShared<FOpenVINOModelWeights>(FrozenWeightsData, FOpenVINOModelView());
+			FrozenWeights->PrivateBytes = FrozenWeightsData->GetView().NumBytes();
+			CompiledWeights = FrozenWeights;
+		}
+		else
+		{
+			CompiledWeights = MakeShared<const FOpenVINOModelWeights>(ModelData, ModelView);
+		}
+	}
+
+	return true;
+}
+
+static bool CompileModelInstance(TSharedRef<UE::NNE::FSharedModelData> ModelData, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, FBlake3Hash& OutSharedKey, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& Options, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest)
+{
+	OutSharedKey = FBlake3Hash();
+	CompiledWeights.Reset();
+
+	FOpenVINOModelView ModelView;
+	if (!ParseModelData(ModelData->GetView(), ModelView))
+	{
+		return false;
+	}
+
+	// Load the model into OpenVINO
+	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	if (!OVModule)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Couldn't find NNERuntimeOpenVINO module."));
+		return false;
+	}
+
+	ov_core_t& OVCore = OVModule->OpenVINOInstance();
+	if (!SupportsDevice(OVCore, DeviceName))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("[%s] device not found."), *DeviceName);
+		return false;
+	}
+
+	FOpenVINOAsyncProgress::SetProgress(AsyncRequest, FOpenVINOAsyncProgress::Parsed);
+
+	if (Options.NeedsPrivateModel())
+	{
+		return DecompressModelData(ModelView) && CompileModelVariant(OVCore, ModelData, ModelView, Options, CompiledModel, CompiledWeights, DeviceName);
+	}
+
+	// Hashing large models takes a while, so it's only done once and only on the paths that need it.
+	// Pre and postprocessing are part of the compiled model, so they're part of the key it's found by.
+	TOptional<FBlake3Hash> ContentHash;
+	auto GetContentHash = [&ModelView, &ContentHash]() -> const FBlake3Hash&
+	{
+		if (!ContentHash.IsSet())
+		{
+			ContentHash = FNNERuntimeOpenVINO::HashModel(ModelView);
+		}
+		return ContentHash.GetValue();
+	};
+
+	const FBlake3Hash PrePostProcessHash = HashPrePostProcessing(Options);
+
+	// The shared store comes first, importing a precompiled blob would give this process a private copy of the weights.
+	// It compiles from staged files, so it needs the model decompressed.
+	if (OVModule->SharesCompiledModels(DeviceName) && DecompressModelData(ModelView) && OVModule->CompileSharedModel(ModelView, GetContentHash(), Options, DeviceName, CompiledModel))
+	{
+		OutSharedKey = GetProcessedModelKey(GetContentHash(), PrePostProcessHash);
+		return true;
+	}
+
+	// Prefer a blob precompiled during cook. It's only usable with the same OpenVINO build,
+	// and the device may still reject it (e.g. different CPU ISA) in which case we compile from source.
+	if (!ModelView.CompiledBlobs.IsEmpty())
+	{
+		const FString OpenVINOVersion(GetOpenVINOVersion());
+		for (const FOpenVINOCompiledBlob& Blob : ModelView.CompiledBlobs)
+		{
+			if (!DeviceName.StartsWith(Blob.DeviceName) || Blob.OpenVINOVersion != OpenVINOVersion || Blob.PrePostProcessHash != PrePostProcessHash)
+			{
+				continue;
+			}
+
+			FSharedBuffer DecompressedBlob;
+			TConstArrayView64<uint8> BlobData;
+			if (DecompressCompiledBlob(Blob, DecompressedBlob, BlobData)
+				&& ov_core_import_model(&OVCore, (const char*)BlobData.GetData(), BlobData.Num(), TCHAR_TO_ANSI(*DeviceName), &CompiledModel) == ov_status_e::OK)
+			{
+				return true;
+			}
+
+			CompiledModel = nullptr;
+			UE_LOG(LogNNERuntimeOpenVINO, Log, TEXT("Precompiled [%s] model couldn't be imported, compiling from source."), *DeviceName);
+		}
+	}
+
+#if WITH_EDITOR
+	// Editor sessions share compiled blobs through the DDC so each model is only compiled once per team.
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	const bool bUseDDC = Settings && Settings->bCacheCompiledModelsInDDC;
+
+	FString CacheKey;
+	if (bUseDDC)
+	{
+		CacheKey = GetCompiledModelCacheKey(OVCore, GetProcessedModelKey(GetContentHash(), PrePostProcessHash), DeviceName);
+
+		TArray64<uint8> CachedBlob;
+		if (GetDerivedDataCacheRef().GetSynchronous(*CacheKey, CachedBlob, TEXT("NNERuntimeOpenVINO")))
+		{
+			if (ov_core_import_model(&OVCore, (const char*)CachedBlob.GetData(), CachedBlob.Num(), TCHAR_TO_ANSI(*DeviceName), &CompiledModel) == ov_status_e::OK)
+			{
+				return true;
+			}
+
+			CompiledModel = nullptr;
+			UE_LOG(LogNNERuntimeOpenVINO, Log, TEXT("Cached [%s] model couldn't be imported, compiling from source."), *DeviceName);
+		}
+	}
+#endif
+
+	if (AsyncRequest && AsyncRequest->IsCancelled())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Verbose, TEXT("Model instance creation cancelled."));
+		return false;
+	}
+
+	TSharedPtr<FOpenVINOSharedModel> SharedModel = OVModule->FindOrReadModel(ModelData, ModelView, GetContentHash(), Options);
+	if (!SharedModel)
+	{
+		return false;
+	}
 
-void ReleasePorts(TArray<ov_output_const_port_t*>& Ports)
-{
-	for (ov_output_const_port_t*& Port : Ports)
+	FOpenVINOAsyncProgress::SetProgress(AsyncRequest, FOpenVINOAsyncProgress::Read);
+
+	if (AsyncRequest && AsyncRequest->IsCancelled())
 	{
-		if (Port)
-		{
-			ov_output_const_port_free(Port);
-		}
+		UE_LOG(LogNNERuntimeOpenVINO, Verbose, TEXT("Model instance creation cancelled."));
+		return false;
 	}
-}
 
-void ReleaseShapes(TArray<ov_shape_t>& Shapes)
-{
-	for (ov_shape_t& Shape : Shapes)
+	ov_status_e CompileResult = ov_status_e::OK;
 	{
-		ov_shape_free(&Shape);
+		FScopeLock CompileLock(&SharedModel->GetCompileLock());
+		CompileResult = ov_core_compile_model(&OVCore, SharedModel->GetModel(), TCHAR_TO_ANSI(*DeviceName), 0, &CompiledModel);
 	}
-}
 
-void ReleasePartialShapes(TArray<ov_partial_shape_t>& Shapes)
-{
-	for (ov_partial_shape_t& Shape : Shapes)
+	if (CompileResult)
 	{
-		ov_partial_shape_free(&Shape);
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to compile the model."));
+		return false;
 	}
-}
 
-void ReleaseTensors(TArray<ov_tensor_t*>& Tensors)
-{
-	for (ov_tensor_t*& Tensor : Tensors)
+	// The read model itself isn't kept, instances compiling it at the same time share it through the registry and later
+	// ones read it again. What its weights point into is, for as long as the compiled model may use them in place.
+	if (UsesWeightsInPlace(DeviceName))
 	{
-		if (Tensor)
+		CompiledWeights = SharedModel->GetWeights();
+	}
+
+#if WITH_EDITOR
+	if (bUseDDC)
+	{
+		TArray64<uint8> CompiledBlob;
+		if (ExportCompiledModel(CompiledModel, CompiledBlob))
 		{
-			ov_tensor_free(Tensor);
+			GetDerivedDataCacheRef().Put(*CacheKey, CompiledBlob, TEXT("NNERuntimeOpenVINO"));
 		}
 	}
+#endif
+
+	return true;
 }
 
-bool InitModelInstance(TSharedRef<UE::NNE::FSharedModelData> ModelData, ov_compiled_model_t*& CompiledModel, const FString& DeviceName)
+FNNERuntimeOpenVINOInstanceOptions ResolveInstanceOptions(const FNNERuntimeOpenVINOInstanceOptions& Options, const FOpenVINOModelDataSource* ModelDataSource)
 {
-	FMemoryReaderView MemoryReader(ModelData->GetView());
-
-	int64 FileDataSize = 0;
-	TConstArrayView64<uint8> FileData;
-	TConstArrayView64<uint8> WeightsData;
+	FNNERuntimeOpenVINOInstanceOptions ResolvedOptions = Options;
 
-	// Note that this is placed at the beginning of the data during cook.
-	bool bHasWeights;
-	MemoryReader << bHasWeights;
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	const FNNERuntimeOpenVINOModelPreProcess* PreProcess = ModelDataSource && Settings ? Settings->PreProcessing.FindByPredicate([ModelDataSource](const FNNERuntimeOpenVINOModelPreProcess& Entry)
+	{
+		return Entry.Model.ToSoftObjectPath() == ModelDataSource->GetAssetPath();
+	}) : nullptr;
 
-	if (bHasWeights)
+	if (PreProcess && ResolvedOptions.PreProcessing.IsEmpty())
 	{
-		int64 WeightsDataSize = 0;
-		MemoryReader << FileDataSize;
-		MemoryReader << WeightsDataSize;
+		ResolvedOptions.PreProcessing = PreProcess->Inputs;
+	}
 
-		int64 FileDataOffset = MemoryReader.Tell();
-		int64 WeightsDataOffset = MemoryReader.Tell() + FileDataSize;
+	if (PreProcess && ResolvedOptions.PostProcessing.IsEmpty())
+	{
+		ResolvedOptions.PostProcessing = PreProcess->Outputs;
+	}
 
-		// Avoid reallocating data since it's already loaded.
-		FileData = TConstArrayView64<uint8>(ModelData->GetView().GetData() + FileDataOffset,
-			FileDataSize);
+	return ResolvedOptions;
+}
 
-		WeightsData = TConstArrayView64<uint8>(ModelData->GetView().GetData() + WeightsDataOffset,
-			WeightsDataSize);
-	}
-	else
+FString ExportPrePostProcessing(const FNNERuntimeOpenVINOInstanceOptions& Options)
+{
+	if (Options.PreProcessing.IsEmpty() && Options.PostProcessing.IsEmpty())
 	{
-		int64 FileDataOffset = MemoryReader.Tell();
-		FileDataSize = ModelData->GetView().NumBytes() - FileDataOffset;
-		FileData = TConstArrayView64<uint8>(ModelData->GetView().GetData() + FileDataOffset,
-			FileDataSize);
+		return FString();
 	}
 
-	// Load the model into OpenVINO
-	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
-	if (!OVModule)
+	FNNERuntimeOpenVINOModelPreProcess PrePostProcessing;
+	PrePostProcessing.Inputs = Options.PreProcessing;
+	PrePostProcessing.Outputs = Options.PostProcessing;
+
+	FString Text;
+	FNNERuntimeOpenVINOModelPreProcess::StaticStruct()->ExportText(Text, &PrePostProcessing, nullptr, nullptr, PPF_None, nullptr);
+	return Text;
+}
+
+bool ImportPrePostProcessing(const FString& Text, FNNERuntimeOpenVINOInstanceOptions& OutOptions)
+{
+	UScriptStruct* Struct = FNNERuntimeOpenVINOModelPreProcess::StaticStruct();
+	FNNERuntimeOpenVINOModelPreProcess PrePostProcessing;
+	if (!Struct->ImportText(*Text, &PrePostProcessing, nullptr, PPF_None, GLog, Struct->GetName()))
 	{
-		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Couldn't find NNERuntimeOpenVINO module."));
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid pre and postprocessing %s."), *Text);
 		return false;
 	}
 
-	ov_core_t& OVCore = OVModule->OpenVINOInstance();
-	if (!SupportsDevice(OVCore, DeviceName))
+	OutOptions.PreProcessing = MoveTemp(PrePostProcessing.Inputs);
+	OutOptions.PostProcessing = MoveTemp(PrePostProcessing.Outputs);
+	return true;
+}
+
+FBlake3Hash HashPrePostProcessing(const FNNERuntimeOpenVINOInstanceOptions& Options)
+{
+	const FString Text = ExportPrePostProcessing(Options);
+	if (Text.IsEmpty())
 	{
-		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("[%s] device not found."), *DeviceName);
-		return false;
+		return FBlake3Hash();
 	}
 
-	ov_model_t* Model = nullptr;
-	ov_status_e LoadResult = ov_status_e::OK;
-	if (!bHasWeights)
+	// Hashed as UTF-8 so the hash stored with precompiled blobs matches on every platform.
+	const FTCHARToUTF8 Utf8Text(*Text);
+	return FBlake3::HashBuffer(Utf8Text.Get(), Utf8Text.Length());
+}
+
+FBlake3Hash GetProcessedModelKey(const FBlake3Hash& ContentHash, const FBlake3Hash& PrePostProcessHash)
+{
+	if (PrePostProcessHash.IsZero())
 	{
-		LoadResult = ov_core_read_model_from_memory_buffer(&OVCore, (const char*)FileData.GetData(), FileData.Num(), NULL, &Model);
+		return ContentHash;
 	}
-	else 
-	{
-		// In the case of IR models, we must create a temporary Tensor as input.
-		// The data for the tensor comes from the asset so there is no additional allocation inside of OpenVINO.
-		ov_shape_t TempShape{};
-		int64_t Dims[1] = { (int64_t)WeightsData.NumBytes() };
-		if (ov_shape_create(1, Dims, &TempShape))
-		{
-			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to setup the IR model."));
-			return false;
-		}
 
-		ov_tensor_t* TempTensor = NULL;
-		if (ov_tensor_create_from_host_ptr(U8, TempShape, (void*)WeightsData.GetData(), &TempTensor))
-		{
-			ov_shape_free(&TempShape);
-			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to setup the IR model."));
-			return false;
-		}
+	FBlake3 Hasher;
+	Hasher.Update(ContentHash.GetBytes(), sizeof(FBlake3Hash::ByteArray));
+	Hasher.Update(PrePostProcessHash.GetBytes(), sizeof(FBlake3Hash::ByteArray));
+	return Hasher.Finalize();
+}
 
-		LoadResult = ov_core_read_model_from_memory_buffer(&OVCore, (const char*)FileData.GetData(), FileData.Num(), TempTensor, &Model);
-		
-		ov_tensor_free(TempTensor);
-		ov_shape_free(&TempShape);
-	}
+bool InitModelInstance(TSharedRef<UE::NNE::FSharedModelData> ModelData, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest, FBlake3Hash& OutSharedKey, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& Options, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest)
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	const int32 WarmUpInferences = Settings ? Settings->WarmUpInferences : 0;
 
-	if (LoadResult)
+	if (!CompileModelInstance(ModelData, CompiledModel, CompiledWeights, OutSharedKey, DeviceName, Options, AsyncRequest))
 	{
-		if (Model)
-		{
-			ov_model_free(Model);
-		}
-
-		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to read the model."));
 		return false;
 	}
 
-	ov_status_e CompileResult = ov_core_compile_model(&OVCore, Model, TCHAR_TO_ANSI(*DeviceName), 0, &CompiledModel);
+	FOpenVINOAsyncProgress::SetProgress(AsyncRequest, FOpenVINOAsyncProgress::Compiled);
 
-	// Once the model is compiled we no longer need to hang onto the source model.
-	ov_model_free(Model);
-	Model = nullptr;
+	if (WarmUpInferences > 0 && !(AsyncRequest && AsyncRequest->IsCancelled()))
+	{
+		WarmUpCompiledModel(CompiledModel, InferRequest, DeviceName, WarmUpInferences);
+	}
 
-	if (CompileResult)
+	return true;
+}
+
+// Tensors are named after the first tensor name of their port, which is also what frozen inputs are matched against.
+static FString GetPortName(const ov_output_const_port_t* Port)
+{
+	char* Name = nullptr;
+	if (ov_port_get_any_name(Port, &Name) || !Name)
 	{
-		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to compile the model."));
+		return FString();
 	}
 
-	return CompileResult == ov_status_e::OK;
+	FString Result(UTF8_TO_TCHAR(Name));
+	ov_free(Name);
+	return Result;
 }
 
 bool InitModelTensorDescs(TArray<UE::NNE::FTensorDesc>& InDescs, TArray<UE::NNE::FTensorDesc>& OutDescs, ov_compiled_model*& CompiledModel)
@@ -338,7 +2039,7 @@ bool InitModelTensorDescs(TArray<UE::NNE::FTensorDesc>& InDescs, TArray<UE::NNE:
 			}
 		}
 
-		UE::NNE::FTensorDesc TensorDesc = UE::NNE::FTensorDesc::Make("", UE::NNE::FSymbolicTensorShape::Make(SymbolicShape), DataType);
+		UE::NNE::FTensorDesc TensorDesc = UE::NNE::FTensorDesc::Make(GetPortName(InputPort), UE::NNE::FSymbolicTensorShape::Make(SymbolicShape), DataType);
 		InDescs.Add(TensorDesc);
 	}
 
@@ -395,7 +2096,7 @@ bool InitModelTensorDescs(TArray<UE::NNE::FTensorDesc>& InDescs, TArray<UE::NNE:
 			}
 		}
 
-		UE::NNE::FTensorDesc TensorDesc = UE::NNE::FTensorDesc::Make("", UE::NNE::FSymbolicTensorShape::Make(SymbolicShape), DataType);
+		UE::NNE::FTensorDesc TensorDesc = UE::NNE::FTensorDesc::Make(GetPortName(OutputPort), UE::NNE::FSymbolicTensorShape::Make(SymbolicShape), DataType);
 		OutDescs.Add(TensorDesc);
 	}
 
@@ -405,7 +2106,109 @@ bool InitModelTensorDescs(TArray<UE::NNE::FTensorDesc>& InDescs, TArray<UE::NNE:
 	return true;
 }
 
-UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, ov_compiled_model_t*& CompiledModel)
+// The C API doesn't report how much memory a compiled model uses, but its weights are about the size of the source.
+static int64 EstimateWeightsFootprint(TConstArrayView64<uint8> ModelData)
+{
+	using namespace UE::NNERuntimeOpenVINO::ModelFormat;
+
+	// Sizes are read from the section table so compressed data isn't decompressed just to be measured.
+	int64 Footprint = ModelData.NumBytes();
+	TArray<FSection> Sections;
+	if (ReadSections(ModelData, Sections))
+	{
+		Footprint = 0;
+		for (const FSection& Section : Sections)
+		{
+			if (Section.Type == ESectionType::Model || Section.Type == ESectionType::Weights || Section.Type == ESectionType::ExternalData)
+			{
+				Footprint += FMath::Max<int64>(GetUncompressedSize(Section), 0);
+			}
+		}
+	}
+
+	return Footprint;
+}
+
+static int64 EstimateTensorsFootprint(TConstArrayView<UE::NNE::FTensorDesc> InDescs, TConstArrayView<UE::NNE::FTensorDesc> OutDescs)
+{
+	int64 Footprint = 0;
+	for (TConstArrayView<UE::NNE::FTensorDesc> Descs : { InDescs, OutDescs })
+	{
+		for (const UE::NNE::FTensorDesc& Desc : Descs)
+		{
+			if (Desc.GetShape().IsConcrete())
+			{
+				Footprint += (int64)UE::NNE::FTensorShape::MakeFromSymbolic(Desc.GetShape()).Volume() * Desc.GetElementByteSize();
+			}
+		}
+	}
+
+	return Footprint;
+}
+
+// Releases the compiled model on behalf of the memory budget. Returns false without waiting if the instance is in use.
+static bool EvictModelInstance(FCriticalSection& InstanceLock, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest)
+{
+	FScopeTryLock Lock(&InstanceLock);
+	if (!Lock.IsLocked() || !CompiledModel)
+	{
+		return false;
+	}
+
+	if (InferRequest)
+	{
+		ov_infer_request_free(InferRequest);
+		InferRequest = nullptr;
+	}
+
+	ov_compiled_model_free(CompiledModel);
+	CompiledModel = nullptr;
+	CompiledWeights.Reset();
+
+	return true;
+}
+
+uint64 RegisterModelInstance(TConstArrayView64<uint8> ModelData, const FBlake3Hash& SharedKey, TConstArrayView<UE::NNE::FTensorDesc> InDescs, TConstArrayView<UE::NNE::FTensorDesc> OutDescs,
+	FCriticalSection& InstanceLock, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest)
+{
+	const int64 Footprint = EstimateTensorsFootprint(InDescs, OutDescs) + (CompiledWeights ? CompiledWeights->PrivateBytes : 0);
+	return FNNERuntimeOpenVINOMemoryBudget::Get().Register(Footprint, SharedKey, EstimateWeightsFootprint(ModelData), [&InstanceLock, &CompiledModel, &CompiledWeights, &InferRequest]()
+	{
+		return EvictModelInstance(InstanceLock, CompiledModel, CompiledWeights, InferRequest);
+	});
+}
+
+// Restores the compiled model if the memory budget evicted it and marks it as used. Call with the instance lock held.
+static bool AcquireModelInstance(TSharedPtr<FOpenVINOModelDataSource> ModelDataSource, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& Options, uint64 BudgetHandle)
+{
+	FNNERuntimeOpenVINOMemoryBudget& MemoryBudget = FNNERuntimeOpenVINOMemoryBudget::Get();
+	if (CompiledModel)
+	{
+		MemoryBudget.Touch(BudgetHandle);
+		return true;
+	}
+
+	// Restoring goes through the same path as creation, so it's an import when a precompiled,
+	// DDC or OpenVINO cached model exists. It still stalls this inference, so it's logged.
+	const double StartTime = FPlatformTime::Seconds();
+
+	FBlake3Hash SharedKey;
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData = ModelDataSource ? ModelDataSource->Get() : nullptr;
+	if (!ModelData || !InitModelInstance(ModelData.ToSharedRef(), CompiledModel, CompiledWeights, InferRequest, SharedKey, DeviceName, Options))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to restore the evicted [%s] model."), *DeviceName);
+		return false;
+	}
+
+	ModelDataSource->ReleaseAfterCompile(DeviceName);
+
+	UE_LOG(LogNNERuntimeOpenVINO, Log, TEXT("Restored the evicted [%s] model in %.1f ms before running it."), *DeviceName, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	MemoryBudget.MarkRestored(BudgetHandle);
+	return true;
+}
+
+UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, ov_compiled_model_t*& CompiledModel, ov_infer_request_t*& InferRequest)
 {
 	if (InInputTensors.IsEmpty() || InOutputTensors.IsEmpty())
 	{
@@ -419,9 +2222,10 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 		return UE::NNE::EResultStatus::Fail;
 	}
 
-	ov_infer_request_t* InferRequest = nullptr;
-	if (ov_compiled_model_create_infer_request(CompiledModel, &InferRequest))
+	// The request lives as long as the compiled model, so the buffers the warm-up or the previous inference set up are reused.
+	if (!InferRequest && ov_compiled_model_create_infer_request(CompiledModel, &InferRequest))
 	{
+		InferRequest = nullptr;
 		ov_compiled_model_free(CompiledModel);
 		CompiledModel = nullptr;
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to create the inference request."));
@@ -441,6 +2245,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(InputShapes);
 			ReleaseTensors(InputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get input config."));
@@ -454,6 +2259,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(InputShapes);
 			ReleaseTensors(InputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get input shape."));
@@ -467,6 +2273,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(InputShapes);
 			ReleaseTensors(InputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get input type."));
@@ -481,6 +2288,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(InputShapes);
 			ReleaseTensors(InputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to create tensor from input data."));
@@ -493,6 +2301,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(InputShapes);
 			ReleaseTensors(InputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to set input tensor for infer request."));
@@ -516,6 +2325,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(OutputShapes);
 			ReleaseTensors(OutputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get output config."));
@@ -532,6 +2342,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(OutputShapes);
 			ReleaseTensors(OutputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get output shape."));
@@ -549,6 +2360,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(OutputShapes);
 			ReleaseTensors(OutputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to get output type."));
@@ -566,6 +2378,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(OutputShapes);
 			ReleaseTensors(OutputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to create tensor from output data."));
@@ -581,6 +2394,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 			ReleaseShapes(OutputShapes);
 			ReleaseTensors(OutputTensors);
 			ov_infer_request_free(InferRequest);
+			InferRequest = nullptr;
 			ov_compiled_model_free(CompiledModel);
 			CompiledModel = nullptr;
 			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to set output tensor for infer request."));
@@ -597,6 +2411,7 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 		ReleaseShapes(OutputShapes);
 		ReleaseTensors(OutputTensors);
 		ov_infer_request_free(InferRequest);
+		InferRequest = nullptr;
 		ov_compiled_model_free(CompiledModel);
 		CompiledModel = nullptr;
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to execute infer request."));
@@ -609,9 +2424,192 @@ UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> In
 	ReleasePorts(OutputPorts);
 	ReleaseShapes(OutputShapes);
 	ReleaseTensors(OutputTensors);
-	ov_infer_request_free(InferRequest);
 
-	// Compiled Model remains valid for the lifetime of the ModelInstance.
+	// Compiled Model and its infer request remain valid for the lifetime of the ModelInstance.
 
 	return UE::NNE::EResultStatus::Ok;
 }
+
+UE::NNE::EResultStatus RunModelInstance(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, TSharedPtr<FOpenVINOModelDataSource> ModelDataSource,
+	FCriticalSection& InstanceLock, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& Options, uint64 BudgetHandle)
+{
+	FScopeLock Lock(&InstanceLock);
+	if (!AcquireModelInstance(ModelDataSource, CompiledModel, CompiledWeights, InferRequest, DeviceName, Options, BudgetHandle))
+	{
+		return UE::NNE::EResultStatus::Fail;
+	}
+
+	UE::NNE::EResultStatus Result = ModelInfer(InInputTensors, InOutputTensors, CompiledModel, InferRequest);
+
+	// A failed inference releases the compiled model.
+	if (!CompiledModel)
+	{
+		CompiledWeights.Reset();
+		FNNERuntimeOpenVINOMemoryBudget::Get().MarkEvicted(BudgetHandle);
+	}
+
+	return Result;
+}
+
+struct FOpenVINOTensorRegionBinding
+{
+	uint8* Region = nullptr;
+	TArray<uint32, TInlineAllocator<8>> Shape;
+	TArray<uint64, TInlineAllocator<8>> Strides;
+	// Leading dimensions iterated when copying, the ones after them form runs of RunSize contiguous bytes.
+	int32 NumOuterDims = 0;
+	uint64 RunSize = 0;
+	// Owned by the instance, only sized for regions that aren't contiguous.
+	TArray64<uint8>* Scratch = nullptr;
+};
+
+static bool BindTensorRegion(const FNNERuntimeOpenVINOTensorRegion& Region, const UE::NNE::FTensorDesc& Desc, const UE::NNE::FTensorShape* Shape, TArray64<uint8>& Scratch, FOpenVINOTensorRegionBinding& OutBinding)
+{
+	if (!Shape && !Desc.GetShape().IsConcrete())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Tensor [%s] has no concrete shape to bind a region to."), *Desc.GetName());
+		return false;
+	}
+
+	const UE::NNE::FTensorShape TensorShape = Shape ? *Shape : UE::NNE::FTensorShape::MakeFromSymbolic(Desc.GetShape());
+	const int32 Rank = TensorShape.Rank();
+	const uint64 ElementSize = Desc.GetElementByteSize();
+
+	if (!Region.Data || (!Region.Strides.IsEmpty() && Region.Strides.Num() != Rank) || (!Region.Origin.IsEmpty() && Region.Origin.Num() != Region.Strides.Num()))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The region bound to tensor [%s] needs data, and strides and an origin for each of its %d dimensions."), *Desc.GetName(), Rank);
+		return false;
+	}
+
+	OutBinding.Shape.Append(TensorShape.GetData().GetData(), Rank);
+	OutBinding.Region = (uint8*)Region.Data;
+	OutBinding.Strides.SetNumUninitialized(Rank);
+
+	uint64 DenseStride = ElementSize;
+	for (int32 Dim = Rank - 1; Dim >= 0; --Dim)
+	{
+		OutBinding.Strides[Dim] = Region.Strides.IsEmpty() ? DenseStride : Region.Strides[Dim];
+		DenseStride *= OutBinding.Shape[Dim];
+	}
+
+	for (int32 Dim = 0; Dim < Region.Origin.Num(); ++Dim)
+	{
+		OutBinding.Region += Region.Origin[Dim] * Region.Strides[Dim];
+	}
+
+	// Collapse the innermost dimensions laid out densely, a region made only of them is bound in place.
+	OutBinding.NumOuterDims = Rank;
+	OutBinding.RunSize = ElementSize;
+	while (OutBinding.NumOuterDims > 0 && (OutBinding.Shape[OutBinding.NumOuterDims - 1] == 1 || OutBinding.Strides[OutBinding.NumOuterDims - 1] == OutBinding.RunSize))
+	{
+		OutBinding.RunSize *= OutBinding.Shape[--OutBinding.NumOuterDims];
+	}
+
+	// The buffer keeps its allocation from the previous run when the shape hasn't grown.
+	if (OutBinding.NumOuterDims > 0)
+	{
+		Scratch.SetNumUninitialized(TensorShape.Volume() * ElementSize, EAllowShrinking::No);
+		OutBinding.Scratch = &Scratch;
+	}
+
+	return true;
+}
+
+static UE::NNE::FTensorBindingCPU GetTensorBinding(FOpenVINOTensorRegionBinding& Binding)
+{
+	if (Binding.NumOuterDims > 0)
+	{
+		return UE::NNE::FTensorBindingCPU{ Binding.Scratch->GetData(), (uint64)Binding.Scratch->Num() };
+	}
+
+	return UE::NNE::FTensorBindingCPU{ Binding.Region, Binding.RunSize };
+}
+
+// Copies between the region and its dense scratch copy, one run of contiguous bytes at a time.
+static void CopyTensorRegion(FOpenVINOTensorRegionBinding& Binding, bool bGather)
+{
+	TArray<uint32, TInlineAllocator<8>> Index;
+	Index.SetNumZeroed(Binding.NumOuterDims);
+
+	uint8* Dense = Binding.Scratch->GetData();
+	uint8* const DenseEnd = Dense + Binding.Scratch->Num();
+	for (; Dense < DenseEnd; Dense += Binding.RunSize)
+	{
+		uint8* Run = Binding.Region;
+		for (int32 Dim = 0; Dim < Binding.NumOuterDims; ++Dim)
+		{
+			Run += Index[Dim] * Binding.Strides[Dim];
+		}
+
+		if (bGather)
+		{
+			FMemory::Memcpy(Dense, Run, Binding.RunSize);
+		}
+		else
+		{
+			FMemory::Memcpy(Run, Dense, Binding.RunSize);
+		}
+
+		for (int32 Dim = Binding.NumOuterDims - 1; Dim >= 0 && ++Index[Dim] == Binding.Shape[Dim]; --Dim)
+		{
+			Index[Dim] = 0;
+		}
+	}
+}
+
+UE::NNE::EResultStatus RunOnTensorRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors,
+	TConstArrayView<UE::NNE::FTensorDesc> InputDescs, TConstArrayView<UE::NNE::FTensorDesc> OutputDescs, TConstArrayView<UE::NNE::FTensorShape> InputShapes,
+	TConstArrayView<UE::NNE::FTensorShape> OutputShapes, TArray<TArray64<uint8>>& Scratch,
+	TFunctionRef<UE::NNE::EResultStatus(TConstArrayView<UE::NNE::FTensorBindingCPU>, TConstArrayView<UE::NNE::FTensorBindingCPU>)> Run)
+{
+	if (InInputTensors.Num() != InputDescs.Num() || InOutputTensors.Num() != OutputDescs.Num())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Input/Output tensors are not set up properly."));
+		return UE::NNE::EResultStatus::Fail;
+	}
+
+	TArray<FOpenVINOTensorRegionBinding> InputRegions;
+	TArray<FOpenVINOTensorRegionBinding> OutputRegions;
+	TArray<UE::NNE::FTensorBindingCPU> InputBindings;
+	TArray<UE::NNE::FTensorBindingCPU> OutputBindings;
+	InputRegions.SetNum(InInputTensors.Num());
+	OutputRegions.SetNum(InOutputTensors.Num());
+	Scratch.SetNum(InInputTensors.Num() + InOutputTensors.Num());
+
+	for (int32 i = 0; i < InInputTensors.Num(); ++i)
+	{
+		if (!BindTensorRegion(InInputTensors[i], InputDescs[i], InputShapes.IsValidIndex(i) ? &InputShapes[i] : nullptr, Scratch[i], InputRegions[i]))
+		{
+			return UE::NNE::EResultStatus::Fail;
+		}
+
+		if (InputRegions[i].NumOuterDims > 0)
+		{
+			CopyTensorRegion(InputRegions[i], true);
+		}
+		InputBindings.Add(GetTensorBinding(InputRegions[i]));
+	}
+
+	for (int32 i = 0; i < InOutputTensors.Num(); ++i)
+	{
+		if (!BindTensorRegion(InOutputTensors[i], OutputDescs[i], OutputShapes.IsValidIndex(i) ? &OutputShapes[i] : nullptr, Scratch[InInputTensors.Num() + i], OutputRegions[i]))
+		{
+			return UE::NNE::EResultStatus::Fail;
+		}
+		OutputBindings.Add(GetTensorBinding(OutputRegions[i]));
+	}
+
+	const UE::NNE::EResultStatus Result = Run(InputBindings, OutputBindings);
+	if (Result == UE::NNE::EResultStatus::Ok)
+	{
+		for (FOpenVINOTensorRegionBinding& OutputRegion : OutputRegions)
+		{
+			if (OutputRegion.NumOuterDims > 0)
+			{
+				CopyTensorRegion(OutputRegion, false);
+			}
+		}
+	}
+
+	return Result;
+}
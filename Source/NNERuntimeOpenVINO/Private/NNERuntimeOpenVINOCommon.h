@@ -34,6 +34,135 @@ THIRD_PARTY_INCLUDES_END
 #include "NNEStatus.h"
 #include "NNERuntimeRunSync.h"
 #include "NNETypes.h"
+#include "Async/Async.h"
+#include "Hash/Blake3.h"
+#include "Memory/SharedBuffer.h"
+#include "Stats/Stats.h"
+#include "Tasks/Task.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "NNERuntimeOpenVINOAsync.h"
+#include "NNERuntimeOpenVINOInstanceOptions.h"
+#include "NNERuntimeOpenVINOModelFormat.h"
+#include "NNERuntimeOpenVINOModule.h"
+#include "NNERuntimeOpenVINOTensorRegion.h"
+
+class ITargetPlatform;
+
+DECLARE_STATS_GROUP(TEXT("NNERuntimeOpenVINO"), STATGROUP_NNERuntimeOpenVINO, STATCAT_Advanced);
+
+/** An exported compiled model stored next to the source model in the model data. */
+struct FOpenVINOCompiledBlob
+{
+	FString DeviceName;
+	FString OpenVINOVersion;
+	/** Still compressed if bCompressed is set, see DecompressCompiledBlob. */
+	TConstArrayView64<uint8> Data;
+	bool bCompressed = false;
+	/** HashPrePostProcessing of the pre and postprocessing compiled into the blob, zero if none. */
+	FBlake3Hash PrePostProcessHash;
+};
+
+struct FOpenVINOExternalData
+{
+	/** Path relative to the model, as the ONNX model refers to it. */
+	FString Location;
+	TConstArrayView64<uint8> Data;
+};
+
+/**
+ * Views into the model data created by CreateOpenVINOModelData, no data is copied.
+ * Compressed model sections are left empty until DecompressModelData is called.
+ */
+struct FOpenVINOModelView
+{
+	bool bHasWeights = false;
+	/** Hash of the model content stored at cook, zero if the model data predates it. See FNNERuntimeOpenVINO::HashModel. */
+	FBlake3Hash ContentHash;
+	TConstArrayView64<uint8> FileData;
+	TConstArrayView64<uint8> WeightsData;
+	/** ONNX models over 2 GB keep their initializers in these files. */
+	TArray<FOpenVINOExternalData> ExternalData;
+	TArray<FOpenVINOCompiledBlob> CompiledBlobs;
+	/** Every section of the container, including types this build doesn't use. */
+	TArray<UE::NNERuntimeOpenVINO::ModelFormat::FSection> Sections;
+	/** The container holding the model sections while they're still compressed. */
+	TConstArrayView64<uint8> CompressedModelData;
+	/** Holds the compressed sections once decompressed, the views above point into them. */
+	TArray<FSharedBuffer> DecompressedData;
+	/** The model data of another runtime holding the model and weights, when this one only refers to it. */
+	TSharedPtr<UE::NNE::FSharedModelData> Payload;
+};
+
+/**
+ * The buffers the IR weights of a model read from memory point into. OpenVINO doesn't copy them when reading,
+ * and the CPU plugin uses them in place in the compiled model, so they must outlive both.
+ */
+struct FOpenVINOModelWeights
+{
+	FOpenVINOModelWeights(TSharedPtr<UE::NNE::FSharedModelData> InModelData, const FOpenVINOModelView& ModelView);
+
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData;
+	TSharedPtr<UE::NNE::FSharedModelData> Payload;
+	TArray<FSharedBuffer> DecompressedData;
+	/** Size of the weights only one instance holds, such as a copy with frozen inputs, zero for the model data's own. */
+	int64 PrivateBytes = 0;
+};
+
+/** A model read by OpenVINO, shared by every instance compiled from identical model data and never modified. */
+class FOpenVINOSharedModel
+{
+public:
+	FOpenVINOSharedModel(TSharedPtr<UE::NNE::FSharedModelData> InModelData, const FOpenVINOModelView& ModelView, ov_model_t* InModel);
+	~FOpenVINOSharedModel();
+
+	const ov_model_t* GetModel() const { return Model; }
+
+	/** What the model's weights point into, to be held by models compiled from it. Null when the weights are memory mapped. */
+	const TSharedPtr<const FOpenVINOModelWeights>& GetWeights() const { return Weights; }
+
+	/** OpenVINO doesn't guarantee that compiling the same model on several threads at once is safe. */
+	FCriticalSection& GetCompileLock() { return CompileLock; }
+
+private:
+	TSharedPtr<const FOpenVINOModelWeights> Weights;
+	ov_model_t* Model = nullptr;
+	FCriticalSection CompileLock;
+};
+
+/**
+ * The model data a model was created from and the asset it came from. When bReleaseModelDataAfterCompile is set,
+ * the model data is dropped once compiled models no longer read it and loaded again from the asset only if the model
+ * must be recompiled.
+ */
+class FOpenVINOModelDataSource
+{
+public:
+	FOpenVINOModelDataSource(TSharedRef<UE::NNE::FSharedModelData> InModelData, UNNEModelData* InAsset, const FString& InRuntimeName);
+
+	/** Returns the model data, loading it from the asset again if it was released. */
+	TSharedPtr<UE::NNE::FSharedModelData> Get();
+
+	/**
+	 * Drops the model data if the setting is on, it can be loaded again and models compiled for the device don't use
+	 * its weights in place. Returns true if it was released.
+	 */
+	bool ReleaseAfterCompile(const FString& DeviceName);
+
+	bool IsValid() const;
+
+	const FSoftObjectPath& GetAssetPath() const { return AssetPath; }
+
+private:
+	/** Registers the model data of another runtime this one refers to, if any. Returns false if it's missing. */
+	bool ResolvePayload(UNNEModelData& Asset, TSharedRef<UE::NNE::FSharedModelData> InModelData);
+
+	mutable FCriticalSection Lock;
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData;
+	TSharedPtr<UE::NNE::FSharedModelData> Payload;
+	FSoftObjectPath AssetPath;
+	FString RuntimeName;
+};
 
 bool IsFileSupported(const FString& FileType);
 
@@ -43,6 +172,8 @@ bool HasMultiGpu(int32& OutGpuCount);
 
 ENNETensorDataType OpenVINOTypeToNNEType(ov_element_type_e ElementType);
 
+ov_element_type_e NNETypeToOpenVINOType(ENNETensorDataType DataType);
+
 void ReleasePorts(TArray<ov_output_const_port_t*>& Ports);
 
 void ReleaseShapes(TArray<ov_shape_t>& Shapes);
@@ -51,8 +182,132 @@ void ReleasePartialShapes(TArray<ov_partial_shape_t>& Shapes);
 
 void ReleaseTensors(TArray<ov_tensor_t*>& Tensors);
 
-bool InitModelInstance(TSharedRef<UE::NNE::FSharedModelData> ModelData, ov_compiled_model_t*& CompiledModel, const FString& DeviceName);
+FString GetOpenVINOVersion();
+
+bool ShouldPrecompileModel(const ITargetPlatform* TargetPlatform);
+
+FString GetModelDataIdentifierSuffix(const FString& FileType, const FGuid& FileId, const FString& DeviceName, const ITargetPlatform* TargetPlatform);
+
+bool ParseModelData(TConstArrayView64<uint8> Data, FOpenVINOModelView& OutView);
+
+/** Decompresses the model, weights and external data if needed. Call before reading them, after any check that can do without. */
+bool DecompressModelData(FOpenVINOModelView& View);
+
+/** Decompresses a compiled blob into OutBuffer if it's compressed, OutData points to the usable blob either way. */
+bool DecompressCompiledBlob(const FOpenVINOCompiledBlob& Blob, FSharedBuffer& OutBuffer, TConstArrayView64<uint8>& OutData);
+
+/** Whether an ONNX external data location stays inside the directory of the model. */
+bool IsValidExternalDataLocation(const FString& Location);
+
+TSharedPtr<UE::NNE::FSharedModelData> CreateOpenVINOModelData(const FString& FileType, TConstArrayView64<uint8> FileData, const TMap<FString, TConstArrayView64<uint8>>& AdditionalFileData, const FGuid& FileId, const FString& DeviceName, const ITargetPlatform* TargetPlatform);
+
+/** ContentHash is the model's FNNERuntimeOpenVINO::HashModel if the caller already has it. */
+bool ReadModel(ov_core_t& OVCore, const FOpenVINOModelView& ModelView, ov_model_t*& Model, const FBlake3Hash* ContentHash = nullptr);
+
+bool ExportCompiledModel(const ov_compiled_model_t* CompiledModel, TArray64<uint8>& OutBlob);
+
+/** The options an instance is created with, completed with the settings of its asset. */
+FNNERuntimeOpenVINOInstanceOptions ResolveInstanceOptions(const FNNERuntimeOpenVINOInstanceOptions& Options, const FOpenVINOModelDataSource* ModelDataSource);
+
+/** Builds the pre and postprocessing of the options into the model, which no one else may use since it's edited. */
+bool ApplyPrePostProcessing(ov_model_t*& Model, const FNNERuntimeOpenVINOInstanceOptions& Options);
+
+/** The pre and postprocessing of the options as text, empty if there's none. */
+FString ExportPrePostProcessing(const FNNERuntimeOpenVINOInstanceOptions& Options);
+bool ImportPrePostProcessing(const FString& Text, FNNERuntimeOpenVINOInstanceOptions& OutOptions);
+
+/** Identifies the pre and postprocessing of the options, zero if there's none. */
+FBlake3Hash HashPrePostProcessing(const FNNERuntimeOpenVINOInstanceOptions& Options);
+
+/** Identifies a model compiled with pre and postprocessing, the content hash itself if there's none. */
+FBlake3Hash GetProcessedModelKey(const FBlake3Hash& ContentHash, const FBlake3Hash& PrePostProcessHash);
+
+/**
+ * Compiles the instance's model. CompiledWeights holds what the compiled model's weights point into, if anything, and must be
+ * released after it. OutSharedKey is set when the compiled weights are shared with other instances of the same model.
+ */
+bool InitModelInstance(TSharedRef<UE::NNE::FSharedModelData> ModelData, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest, FBlake3Hash& OutSharedKey, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& Options, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest = nullptr);
 
 bool InitModelTensorDescs(TArray<UE::NNE::FTensorDesc>& InDescs, TArray<UE::NNE::FTensorDesc>& OutDescs, ov_compiled_model_t*& CompiledModel);
 
-UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, ov_compiled_model_t*& CompiledModel);
+/**
+ * Tracks the instance's compiled model in the memory budget, which may release it while the instance lock is free.
+ * Its footprint is estimated from the model size plus its input and output buffers and the private weights it holds.
+ * Weights shared under SharedKey are counted once.
+ */
+uint64 RegisterModelInstance(TConstArrayView64<uint8> ModelData, const FBlake3Hash& SharedKey, TConstArrayView<UE::NNE::FTensorDesc> InDescs, TConstArrayView<UE::NNE::FTensorDesc> OutDescs,
+	FCriticalSection& InstanceLock, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest);
+
+/** Runs an inference in process, first restoring the compiled model if the memory budget released it. */
+UE::NNE::EResultStatus RunModelInstance(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, TSharedPtr<FOpenVINOModelDataSource> ModelDataSource,
+	FCriticalSection& InstanceLock, ov_compiled_model_t*& CompiledModel, TSharedPtr<const FOpenVINOModelWeights>& CompiledWeights, ov_infer_request_t*& InferRequest, const FString& DeviceName, const FNNERuntimeOpenVINOInstanceOptions& Options, uint64 BudgetHandle);
+
+UE::NNE::EResultStatus ModelInfer(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, ov_compiled_model_t*& CompiledModel, ov_infer_request_t*& InferRequest);
+
+/**
+ * Calls Run with bindings for tensor regions. Contiguous regions are bound in place. The others are gathered into a
+ * dense copy before Run for inputs, or scattered from one after it for outputs. The copies are kept in Scratch,
+ * one per tensor, so repeated runs don't allocate.
+ */
+UE::NNE::EResultStatus RunOnTensorRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors,
+	TConstArrayView<UE::NNE::FTensorDesc> InputDescs, TConstArrayView<UE::NNE::FTensorDesc> OutputDescs, TConstArrayView<UE::NNE::FTensorShape> InputShapes,
+	TConstArrayView<UE::NNE::FTensorShape> OutputShapes, TArray<TArray64<uint8>>& Scratch,
+	TFunctionRef<UE::NNE::EResultStatus(TConstArrayView<UE::NNE::FTensorBindingCPU>, TConstArrayView<UE::NNE::FTensorBindingCPU>)> Run);
+
+/** Reports the stages of an async instance creation, the request itself is read-only to its users. */
+struct FOpenVINOAsyncProgress
+{
+	static constexpr float Parsed = 0.1f;
+	static constexpr float Read = 0.4f;
+	static constexpr float Compiled = 0.8f;
+
+	static void SetProgress(FNNERuntimeOpenVINOAsyncRequest* Request, float Progress)
+	{
+		if (Request)
+		{
+			Request->SetProgress(Progress);
+		}
+	}
+
+	static void MarkDone(FNNERuntimeOpenVINOAsyncRequest& Request)
+	{
+		Request.MarkDone();
+	}
+};
+
+/** Runs InstanceType::Init() on a background task and hands the result to OnCreated on the game thread. */
+template<typename InstanceType, typename InterfaceType>
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> CreateModelInstanceAsync(TSharedRef<FOpenVINOModelDataSource> ModelDataSource, const FNNERuntimeOpenVINOInstanceOptions& Options, TDelegate<void(TSharedPtr<InterfaceType>)> OnCreated, const UObject* Owner)
+{
+	TSharedRef<FNNERuntimeOpenVINOAsyncRequest> Request = MakeShared<FNNERuntimeOpenVINOAsyncRequest>(Owner);
+
+	// Get the model data on the calling thread, reloading a released asset isn't safe from the task.
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData = ModelDataSource->Get();
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [ModelData, ModelDataSource, Options, Request, OnCreated = MoveTemp(OnCreated)]()
+	{
+		TSharedPtr<InstanceType> ModelInstance = MakeShared<InstanceType>();
+		if (!ModelData || !ModelInstance->Init(ModelData.ToSharedRef(), ModelDataSource, Options, &Request.Get()))
+		{
+			if (!Request->IsCancelled())
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to initialize the model instance."));
+			}
+
+			ModelInstance.Reset();
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [ModelInstance, Request, OnCreated]()
+		{
+			FOpenVINOAsyncProgress::MarkDone(Request.Get());
+
+			// Drop the instance if the requester went away while we were compiling.
+			if (!Request->IsCancelled())
+			{
+				OnCreated.ExecuteIfBound(ModelInstance);
+			}
+		});
+	}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+
+	return Request;
+}
@@ -24,11 +24,11 @@
 
 #include "NNERuntimeOpenVINOCpu.h"
 
-#include "Memory/SharedBuffer.h"
 #include "NNE.h"
 #include "NNEModelData.h"
 #include "NNERuntimeOpenVINOCommon.h"
-#include "Serialization/MemoryWriter.h"
+#include "NNERuntimeOpenVINODaemon.h"
+#include "NNERuntimeOpenVINOMemoryBudget.h"
 
 THIRD_PARTY_INCLUDES_START
 #include "openvino/c/ov_prepostprocess.h"
@@ -36,20 +36,45 @@ THIRD_PARTY_INCLUDES_START
 THIRD_PARTY_INCLUDES_END
 
 FGuid UNNERuntimeOpenVINOCpu::GUID = FGuid((int32)'O', (int32)'V', (int32)'_', (int32)'C');
-int32 UNNERuntimeOpenVINOCpu::Version = 0x00000001;
+int32 UNNERuntimeOpenVINOCpu::Version = 0x00000003;
 
 FModelInstanceOpenVINOCpu::~FModelInstanceOpenVINOCpu()
 {
+	if (BudgetHandle)
+	{
+		FNNERuntimeOpenVINOMemoryBudget::Get().Unregister(BudgetHandle);
+	}
+
+	if (InferRequest)
+	{
+		ov_infer_request_free(InferRequest);
+	}
+
 	if (CompiledModel)
 	{
 		ov_compiled_model_free(CompiledModel);
 	}
 }
 
-bool FModelInstanceOpenVINOCpu::Init(TSharedRef<UE::NNE::FSharedModelData> ModelData)
+bool FModelInstanceOpenVINOCpu::Init(TSharedRef<UE::NNE::FSharedModelData> ModelData, TSharedPtr<FOpenVINOModelDataSource> InModelDataSource, const FNNERuntimeOpenVINOInstanceOptions& InOptions, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest)
 {
-	const FString DeviceName(TEXT("CPU"));
-	if (!InitModelInstance(ModelData, CompiledModel, DeviceName))
+	Options = ResolveInstanceOptions(InOptions, InModelDataSource.Get());
+	DeviceName = TEXT("CPU");
+
+	// The daemon compiles the model with its pre and postprocessing, but not private variants of it.
+	if (!Options.NeedsPrivateModel() && ShouldUseInferenceDaemon())
+	{
+		DaemonClient = FOpenVINODaemonClient::Connect(ModelData, Options, InputSymbolicTensors, OutputSymbolicTensors);
+		if (DaemonClient)
+		{
+			return true;
+		}
+
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Falling back to in-process inference."));
+	}
+
+	FBlake3Hash SharedKey;
+	if (!InitModelInstance(ModelData, CompiledModel, CompiledWeights, InferRequest, SharedKey, DeviceName, Options, AsyncRequest))
 	{
 		return false;
 	}
@@ -63,6 +88,13 @@ bool FModelInstanceOpenVINOCpu::Init(TSharedRef<UE::NNE::FSharedModelData> Model
 		CompiledModel = nullptr;
 	}
 
+	if (bResult)
+	{
+		ModelDataSource = InModelDataSource;
+
+		BudgetHandle = RegisterModelInstance(ModelData->GetView(), SharedKey, InputSymbolicTensors, OutputSymbolicTensors, CompiledModelLock, CompiledModel, CompiledWeights, InferRequest);
+	}
+
 	return bResult;
 }
 
@@ -88,7 +120,8 @@ TConstArrayView<UE::NNE::FTensorShape> FModelInstanceOpenVINOCpu::GetOutputTenso
 
 UE::NNE::EResultStatus FModelInstanceOpenVINOCpu::SetInputTensorShapes(TConstArrayView<UE::NNE::FTensorShape> InInputShapes)
 {
-	if (!CompiledModel)
+	// An evicted instance has no compiled model but keeps its model data to restore from.
+	if (!CompiledModel && !DaemonClient && !(ModelDataSource && ModelDataSource->IsValid()))
 	{
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid compiled model."));
 		return UE::NNE::EResultStatus::Fail;
@@ -111,31 +144,85 @@ UE::NNE::EResultStatus FModelInstanceOpenVINOCpu::SetInputTensorShapes(TConstArr
 	}
 
 	InputTensorShapes = InInputShapes;
+
+	// Output shapes are only known up front when the model's are concrete, which is what output regions take their extents from.
+	OutputTensorShapes.Reset(OutputSymbolicTensors.Num());
+	for (const UE::NNE::FTensorDesc& OutputDesc : OutputSymbolicTensors)
+	{
+		if (!OutputDesc.GetShape().IsConcrete())
+		{
+			OutputTensorShapes.Reset();
+			break;
+		}
+
+		OutputTensorShapes.Add(UE::NNE::FTensorShape::MakeFromSymbolic(OutputDesc.GetShape()));
+	}
+
 	return UE::NNE::EResultStatus::Ok;
 }
 
 UE::NNE::EResultStatus FModelInstanceOpenVINOCpu::RunSync(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors)
 {
-	return ModelInfer(InInputTensors, InOutputTensors, CompiledModel);
+	if (DaemonClient)
+	{
+		return DaemonClient->Run(InInputTensors, InOutputTensors, InputTensorShapes, OutputTensorShapes);
+	}
+
+	return RunModelInstance(InInputTensors, InOutputTensors, ModelDataSource, CompiledModelLock, CompiledModel, CompiledWeights, InferRequest, DeviceName, Options, BudgetHandle);
+}
+
+UE::NNE::EResultStatus FModelInstanceOpenVINOCpu::RunSyncOnRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors)
+{
+	FScopeLock ScopeLock(&RegionScratchLock);
+
+	return RunOnTensorRegions(InInputTensors, InOutputTensors, InputSymbolicTensors, OutputSymbolicTensors, InputTensorShapes, OutputTensorShapes, RegionScratch,
+		[this](TConstArrayView<UE::NNE::FTensorBindingCPU> Inputs, TConstArrayView<UE::NNE::FTensorBindingCPU> Outputs)
+		{
+			return RunSync(Inputs, Outputs);
+		});
 }
 
-FModelOpenVINOCpu::FModelOpenVINOCpu(TSharedRef<UE::NNE::FSharedModelData> InModelData)
-	: ModelData(InModelData)
+FModelOpenVINOCpu::FModelOpenVINOCpu(TSharedRef<FOpenVINOModelDataSource> InModelDataSource)
+	: ModelDataSource(InModelDataSource)
 {
 }
 
 TSharedPtr<UE::NNE::IModelInstanceCPU> FModelOpenVINOCpu::CreateModelInstanceCPU()
 {
+	return CreateModelInstanceCPU(FNNERuntimeOpenVINOInstanceOptions());
+}
+
+TSharedPtr<UE::NNE::IModelInstanceCPU> FModelOpenVINOCpu::CreateModelInstanceCPU(const FNNERuntimeOpenVINOInstanceOptions& InOptions)
+{
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData = ModelDataSource->Get();
+
 	TSharedPtr<FModelInstanceOpenVINOCpu> ModelInstance = MakeShared<FModelInstanceOpenVINOCpu>();
-	if (!ModelInstance->Init(ModelData))
+	if (!ModelData || !ModelInstance->Init(ModelData.ToSharedRef(), ModelDataSource, InOptions))
 	{
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to initialize the model instance."));
 		return {};
 	}
 
+	ModelDataSource->ReleaseAfterCompile(TEXT("CPU"));
+
 	return ModelInstance;
 }
 
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> FModelOpenVINOCpu::CreateModelInstanceCPUAsync(FOnModelInstanceOpenVINOCpuCreated OnCreated, const UObject* Owner)
+{
+	return CreateModelInstanceCPUAsync(FNNERuntimeOpenVINOInstanceOptions(), MoveTemp(OnCreated), Owner);
+}
+
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> FModelOpenVINOCpu::CreateModelInstanceCPUAsync(const FNNERuntimeOpenVINOInstanceOptions& InOptions, FOnModelInstanceOpenVINOCpuCreated OnCreated, const UObject* Owner)
+{
+	TSharedRef<FNNERuntimeOpenVINOAsyncRequest> Request = CreateModelInstanceAsync<FModelInstanceOpenVINOCpu, UE::NNE::IModelInstanceCPU>(ModelDataSource, InOptions, MoveTemp(OnCreated), Owner);
+
+	// The task holds its own reference to the model data until it has compiled.
+	ModelDataSource->ReleaseAfterCompile(TEXT("CPU"));
+
+	return Request;
+}
+
 FString UNNERuntimeOpenVINOCpu::GetRuntimeName() const
 {
 	return TEXT("NNERuntimeOpenVINOCpu");
@@ -154,22 +241,12 @@ TSharedPtr<UE::NNE::FSharedModelData> UNNERuntimeOpenVINOCpu::CreateModelData(co
 		return {};
 	}
 
-	bool bHasWeights = FileType.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0;
-
-	TArray64<uint8> WrappedFileData;
-	FMemoryWriter64 MemoryWriter(WrappedFileData);
-	MemoryWriter << bHasWeights;
-	MemoryWriter.Serialize((void*)FileData.GetData(), FileData.NumBytes());
-
-	FSharedBuffer SharedBuffer(FSharedBuffer::Clone(WrappedFileData.GetData(), WrappedFileData.NumBytes()));
-	
-	TSharedPtr<UE::NNE::FSharedModelData> SharedData(MakeShared<UE::NNE::FSharedModelData>(SharedBuffer, 0));
-	return SharedData;
+	return CreateOpenVINOModelData(FileType, FileData, AdditionalFileData, FileId, TEXT("CPU"), TargetPlatform);
 }
 
 FString UNNERuntimeOpenVINOCpu::GetModelDataIdentifier(const FString& FileType, TConstArrayView64<uint8> FileData, const TMap<FString, TConstArrayView64<uint8>>& AdditionalFileData, const FGuid& FileId, const ITargetPlatform* TargetPlatform) const
 {
-	return FileId.ToString(EGuidFormats::Digits) + "-" + UNNERuntimeOpenVINOCpu::GUID.ToString(EGuidFormats::Digits) + "-" + FString::FromInt(UNNERuntimeOpenVINOCpu::Version);
+	return FileId.ToString(EGuidFormats::Digits) + "-" + UNNERuntimeOpenVINOCpu::GUID.ToString(EGuidFormats::Digits) + "-" + FString::FromInt(UNNERuntimeOpenVINOCpu::Version) + GetModelDataIdentifierSuffix(FileType, FileId, TEXT("CPU"), TargetPlatform);
 }
 
 INNERuntimeCPU::ECanCreateModelCPUStatus UNNERuntimeOpenVINOCpu::CanCreateModelCPU(const TObjectPtr<UNNEModelData> ModelData) const
@@ -204,5 +281,5 @@ TSharedPtr<UE::NNE::IModelCPU> UNNERuntimeOpenVINOCpu::CreateModelCPU(const TObj
 	}
 
 	TSharedRef<UE::NNE::FSharedModelData> SharedData = ModelData->GetModelData(GetRuntimeName()).ToSharedRef();
-	return MakeShared<FModelOpenVINOCpu>(SharedData);
+	return MakeShared<FModelOpenVINOCpu>(MakeShared<FOpenVINOModelDataSource>(SharedData, ModelData, GetRuntimeName()));
 }
@@ -0,0 +1,864 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "NNERuntimeOpenVINODaemon.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+
+#include "NNERuntimeOpenVINOCommon.h"
+#include "NNERuntimeOpenVINOModule.h"
+#include "NNERuntimeOpenVINOSettings.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "openvino/c/ov_compiled_model.h"
+#include "openvino/c/ov_infer_request.h"
+#include "openvino/c/ov_property.h"
+#include "openvino/c/ov_tensor.h"
+THIRD_PARTY_INCLUDES_END
+
+#include <atomic>
+
+using namespace UE::NNERuntimeOpenVINO::Daemon;
+
+namespace UE::NNERuntimeOpenVINO::Daemon::Private
+{
+	constexpr uint64 PollNanoseconds = 100ull * 1000 * 1000;
+	constexpr uint64 RegisterTimeoutNanoseconds = 120ull * 1000 * 1000 * 1000;
+	constexpr uint64 InferTimeoutNanoseconds = 30ull * 1000 * 1000 * 1000;
+	constexpr uint64 DataAlignment = 64;
+
+	const uint32 ReadWrite = FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write;
+
+	FString GetDaemonName()
+	{
+		const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+		return Settings && !Settings->InferenceDaemonName.IsEmpty() ? Settings->InferenceDaemonName : TEXT("UEOpenVINO");
+	}
+
+	FString GetModelDirectory()
+	{
+		const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+		const FString Directory = Settings ? Settings->SharedModelDirectory : FString();
+		return FPaths::Combine(FPaths::IsRelative(Directory) ? FPaths::Combine(FPaths::ProjectSavedDir(), Directory) : Directory, TEXT("Models"));
+	}
+
+	bool IsDaemonProcess()
+	{
+		return FParse::Param(FCommandLine::Get(), TEXT("OpenVINODaemon"));
+	}
+
+	// Interprocess semaphores start with one free slot, a signal has to start empty.
+	FPlatformProcess::FSemaphore* CreateSignal(const FString& Name)
+	{
+		FPlatformProcess::FSemaphore* Semaphore = FPlatformProcess::NewInterprocessSynchObject(Name, true, 1);
+		if (Semaphore)
+		{
+			Semaphore->Lock();
+		}
+		return Semaphore;
+	}
+
+	void DeleteSemaphore(FPlatformProcess::FSemaphore*& Semaphore)
+	{
+		if (Semaphore)
+		{
+			FPlatformProcess::DeleteInterprocessSynchObject(Semaphore);
+			Semaphore = nullptr;
+		}
+	}
+
+	void UnmapRegion(FPlatformMemory::FSharedMemoryRegion*& Region)
+	{
+		if (Region)
+		{
+			FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+			Region = nullptr;
+		}
+	}
+
+	bool FillTensorInfos(ov_compiled_model_t* CompiledModel, bool bInputs, int32& OutNum, FTensorInfo* OutInfos)
+	{
+		size_t Size = 0;
+		if ((bInputs ? ov_compiled_model_inputs_size(CompiledModel, &Size) : ov_compiled_model_outputs_size(CompiledModel, &Size)) || Size > MaxTensors)
+		{
+			return false;
+		}
+
+		OutNum = (int32)Size;
+		for (size_t i = 0; i < Size; ++i)
+		{
+			ov_output_const_port_t* Port = nullptr;
+			if (bInputs ? ov_compiled_model_input_by_index(CompiledModel, i, &Port) : ov_compiled_model_output_by_index(CompiledModel, i, &Port))
+			{
+				return false;
+			}
+
+			ov_element_type_e ElementType{};
+			ov_partial_shape_t Shape{};
+			const bool bValid = !ov_port_get_element_type(Port, &ElementType) && !ov_port_get_partial_shape(Port, &Shape) && Shape.rank.min <= MaxRank;
+			ov_output_const_port_free(Port);
+
+			if (!bValid)
+			{
+				ov_partial_shape_free(&Shape);
+				return false;
+			}
+
+			FTensorInfo& Info = OutInfos[i];
+			FMemory::Memzero(Info);
+			Info.ElementType = (int32)ElementType;
+			Info.Rank = (int32)Shape.rank.min;
+			for (int32 j = 0; j < Info.Rank; ++j)
+			{
+				const bool bDynamic = ov_dimension_is_dynamic(Shape.dims[j]) || Shape.dims[j].min != Shape.dims[j].max;
+				Info.Dims[j] = bDynamic ? -1 : Shape.dims[j].min;
+			}
+
+			ov_partial_shape_free(&Shape);
+		}
+
+		return true;
+	}
+
+	/** Serves one model instance of a game process. */
+	class FChannel : public FRunnable
+	{
+	public:
+		FChannel(const FString& InModelKey, uint32 InProcessId, ov_infer_request_t* InInferRequest, FPlatformMemory::FSharedMemoryRegion* InRegion, FPlatformProcess::FSemaphore* InRequestSemaphore, FPlatformProcess::FSemaphore* InResponseSemaphore)
+			: ModelKey(InModelKey)
+			, ProcessId(InProcessId)
+			, InferRequest(InInferRequest)
+			, Region(InRegion)
+			, RequestSemaphore(InRequestSemaphore)
+			, ResponseSemaphore(InResponseSemaphore)
+		{
+		}
+
+		virtual ~FChannel()
+		{
+			if (Thread)
+			{
+				Thread->Kill(true);
+				delete Thread;
+			}
+
+			ov_infer_request_free(InferRequest);
+			DeleteSemaphore(RequestSemaphore);
+			DeleteSemaphore(ResponseSemaphore);
+			UnmapRegion(Region);
+		}
+
+		void Start(const FString& Name)
+		{
+			Thread = FRunnableThread::Create(this, *Name, 128 * 1024, TPri_Normal);
+		}
+
+		bool IsFinished() const
+		{
+			return bFinished;
+		}
+
+		// A client that crashed never closes its channel.
+		bool IsClientAlive() const
+		{
+			return FPlatformProcess::IsApplicationRunning(ProcessId);
+		}
+
+		const FString& GetModelKey() const
+		{
+			return ModelKey;
+		}
+
+		virtual uint32 Run() override
+		{
+			FChannelHeader& Header = *(FChannelHeader*)Region->GetAddress();
+			while (!bStopping)
+			{
+				if (!RequestSemaphore->TryLock(PollNanoseconds))
+				{
+					continue;
+				}
+
+				if (Header.bClosed)
+				{
+					break;
+				}
+
+				Header.Status = Infer(Header) ? 0 : 1;
+				ResponseSemaphore->Unlock();
+			}
+
+			bFinished = true;
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping = true;
+		}
+
+	private:
+		bool Infer(FChannelHeader& Header)
+		{
+			uint8* Base = (uint8*)Region->GetAddress();
+			const uint64 RegionSize = Region->GetSize();
+
+			// Inputs are bound in place, the daemon never copies them out of the channel.
+			TArray<ov_tensor_t*> InputTensors;
+			bool bResult = Header.NumInputs >= 0 && Header.NumInputs <= MaxTensors && Header.NumOutputs >= 0 && Header.NumOutputs <= MaxTensors;
+			for (int32 i = 0; bResult && i < Header.NumInputs; ++i)
+			{
+				const FTensorInfo& Info = Header.Inputs[i];
+				bResult = Info.Rank >= 0 && Info.Rank <= MaxRank && Info.Size <= RegionSize && Info.Offset <= RegionSize - Info.Size;
+
+				ov_shape_t Shape{};
+				if (bResult && ov_shape_create(Info.Rank, Info.Dims, &Shape))
+				{
+					bResult = false;
+				}
+
+				// The shape comes from the client, a tensor larger than its data would read past it, possibly out of the region.
+				ov_tensor_t*& Tensor = InputTensors.AddZeroed_GetRef();
+				size_t ByteSize = 0;
+				if (bResult && (ov_tensor_create_from_host_ptr((ov_element_type_e)Info.ElementType, Shape, Base + Info.Offset, &Tensor)
+					|| ov_tensor_get_byte_size(Tensor, &ByteSize)))
+				{
+					bResult = false;
+				}
+				else if (bResult && ByteSize > Info.Size)
+				{
+					UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Daemon input [%d] needs %llu bytes for its shape but the client only provided %llu."), i, (uint64)ByteSize, Info.Size);
+					bResult = false;
+				}
+				else if (bResult && ov_infer_request_set_input_tensor_by_index(InferRequest, i, Tensor))
+				{
+					bResult = false;
+				}
+
+				ov_shape_free(&Shape);
+			}
+
+			if (bResult && ov_infer_request_infer(InferRequest))
+			{
+				bResult = false;
+			}
+
+			for (int32 i = 0; bResult && i < Header.NumOutputs; ++i)
+			{
+				FTensorInfo& Info = Header.Outputs[i];
+				if (Info.Size == 0)
+				{
+					continue;
+				}
+
+				ov_tensor_t* Tensor = nullptr;
+				ov_shape_t Shape{};
+				void* Data = nullptr;
+				size_t ByteSize = 0;
+				if (ov_infer_request_get_output_tensor_by_index(InferRequest, i, &Tensor) || ov_tensor_get_shape(Tensor, &Shape)
+					|| ov_tensor_data(Tensor, &Data) || ov_tensor_get_byte_size(Tensor, &ByteSize) || Shape.rank > MaxRank || Info.Size > RegionSize || Info.Offset > RegionSize - Info.Size)
+				{
+					bResult = false;
+				}
+				else if (ByteSize > Info.Size)
+				{
+					// The client's buffer is too small, a truncated tensor would look like a valid result.
+					UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Daemon output [%d] needs %llu bytes but the client only provided %llu."), i, (uint64)ByteSize, Info.Size);
+					bResult = false;
+				}
+				else
+				{
+					Info.Rank = (int32)Shape.rank;
+					for (int32 j = 0; j < Info.Rank; ++j)
+					{
+						Info.Dims[j] = Shape.dims[j];
+					}
+
+					FMemory::Memcpy(Base + Info.Offset, Data, ByteSize);
+					Info.Size = ByteSize;
+				}
+
+				ov_shape_free(&Shape);
+				if (Tensor)
+				{
+					ov_tensor_free(Tensor);
+				}
+			}
+
+			ReleaseTensors(InputTensors);
+			return bResult;
+		}
+
+		FString ModelKey;
+		uint32 ProcessId = 0;
+		ov_infer_request_t* InferRequest = nullptr;
+		FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+		FPlatformProcess::FSemaphore* RequestSemaphore = nullptr;
+		FPlatformProcess::FSemaphore* ResponseSemaphore = nullptr;
+		FRunnableThread* Thread = nullptr;
+		std::atomic<bool> bStopping{ false };
+		std::atomic<bool> bFinished{ false };
+	};
+
+	/** Accepts registrations from game processes and compiles each staged model once for all of them. */
+	class FDaemon : public FRunnable
+	{
+	public:
+		FDaemon(ov_core_t& InOVCore)
+			: OVCore(InOVCore)
+			, Name(GetDaemonName())
+		{
+		}
+
+		virtual ~FDaemon()
+		{
+			if (Thread)
+			{
+				Thread->Kill(true);
+				delete Thread;
+			}
+
+			Channels.Empty();
+
+			for (TPair<FString, ov_compiled_model_t*>& CompiledModel : CompiledModels)
+			{
+				ov_compiled_model_free(CompiledModel.Value);
+			}
+
+			DeleteSemaphore(ControlLock);
+			DeleteSemaphore(ControlRequest);
+			DeleteSemaphore(ControlResponse);
+			UnmapRegion(ControlRegion);
+		}
+
+		bool Start()
+		{
+			ControlRegion = FPlatformMemory::MapNamedSharedMemoryRegion(Name + TEXT("_Control"), true, ReadWrite, sizeof(FControlBlock));
+			ControlLock = FPlatformProcess::NewInterprocessSynchObject(Name + TEXT("_Lock"), true, 1);
+			ControlRequest = CreateSignal(Name + TEXT("_Request"));
+			ControlResponse = CreateSignal(Name + TEXT("_Response"));
+
+			if (!ControlRegion || !ControlLock || !ControlRequest || !ControlResponse)
+			{
+				return false;
+			}
+
+			FControlBlock& Control = *(FControlBlock*)ControlRegion->GetAddress();
+			FMemory::Memzero(Control);
+			Control.Magic = Magic;
+			Control.Version = ProtocolVersion;
+
+			Thread = FRunnableThread::Create(this, TEXT("OpenVINODaemon"), 128 * 1024, TPri_Normal);
+			return Thread != nullptr;
+		}
+
+		virtual uint32 Run() override
+		{
+			while (!bStopping)
+			{
+				if (ControlRequest->TryLock(PollNanoseconds))
+				{
+					HandleRegistration();
+				}
+
+				ReapChannels();
+			}
+
+			return 0;
+		}
+
+		virtual void Stop() override
+		{
+			bStopping = true;
+		}
+
+	private:
+		// Removes the channels of clients that closed them or crashed, and frees the compiled models no channel uses anymore.
+		void ReapChannels()
+		{
+			const int32 NumRemoved = Channels.RemoveAll([](const TUniquePtr<FChannel>& Channel)
+			{
+				if (Channel->IsFinished())
+				{
+					return true;
+				}
+
+				if (!Channel->IsClientAlive())
+				{
+					UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Daemon closing the channel of a client that exited without closing it."));
+					return true;
+				}
+
+				return false;
+			});
+
+			if (NumRemoved == 0)
+			{
+				return;
+			}
+
+			for (auto It = CompiledModels.CreateIterator(); It; ++It)
+			{
+				const bool bUsed = Channels.ContainsByPredicate([&It](const TUniquePtr<FChannel>& Channel) { return Channel->GetModelKey() == It.Key(); });
+				if (!bUsed)
+				{
+					UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Daemon released %s."), *It.Key());
+					ov_compiled_model_free(It.Value());
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		// Compiled models are shared by the clients registering the same model with the same pre and postprocessing.
+		static FString GetModelKey(const FString& ModelPath, const FString& PrePostProcessPath)
+		{
+			return PrePostProcessPath.IsEmpty() ? ModelPath : ModelPath + TEXT("|") + PrePostProcessPath;
+		}
+
+		ov_compiled_model_t* FindOrCompileModel(const FString& ModelPath, const FString& PrePostProcessPath)
+		{
+			const FString ModelKey = GetModelKey(ModelPath, PrePostProcessPath);
+			if (ov_compiled_model_t** Found = CompiledModels.Find(ModelKey))
+			{
+				return *Found;
+			}
+
+			// Throughput mode runs the requests of all processes concurrently in one set of streams.
+			ov_compiled_model_t* CompiledModel = nullptr;
+			if (PrePostProcessPath.IsEmpty())
+			{
+				if (ov_core_compile_model_from_file(&OVCore, TCHAR_TO_UTF8(*ModelPath), "CPU", 2, &CompiledModel, ov_property_key_hint_performance_mode, "THROUGHPUT"))
+				{
+					UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Daemon failed to compile %s."), *ModelPath);
+					return nullptr;
+				}
+			}
+			else
+			{
+				// The model is read for this alone, so the pre and postprocessing can edit it.
+				FString PrePostProcessText;
+				FNNERuntimeOpenVINOInstanceOptions PrePostProcessing;
+				ov_model_t* Model = nullptr;
+				const bool bCompiled = FFileHelper::LoadFileToString(PrePostProcessText, *PrePostProcessPath)
+					&& ImportPrePostProcessing(PrePostProcessText, PrePostProcessing)
+					&& !ov_core_read_model(&OVCore, TCHAR_TO_UTF8(*ModelPath), nullptr, &Model)
+					&& ApplyPrePostProcessing(Model, PrePostProcessing)
+					&& !ov_core_compile_model(&OVCore, Model, "CPU", 2, &CompiledModel, ov_property_key_hint_performance_mode, "THROUGHPUT");
+
+				if (Model)
+				{
+					ov_model_free(Model);
+				}
+
+				if (!bCompiled)
+				{
+					UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Daemon failed to compile %s with the pre and postprocessing in %s."), *ModelPath, *PrePostProcessPath);
+					return nullptr;
+				}
+			}
+
+			UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Daemon compiled %s."), *ModelKey);
+			CompiledModels.Add(ModelKey, CompiledModel);
+			return CompiledModel;
+		}
+
+		void HandleRegistration()
+		{
+			FControlBlock& Control = *(FControlBlock*)ControlRegion->GetAddress();
+
+			// Compiling takes long enough for the client to time out and another one to take the slot,
+			// so the answer has to name the request it was made for.
+			const uint64 RequestId = Control.RequestId;
+			const uint32 ProcessId = Control.ProcessId;
+			Control.ModelPath[MaxPath - 1] = 0;
+			Control.PrePostProcessPath[MaxPath - 1] = 0;
+			Control.ChannelName[MaxName - 1] = 0;
+			Control.Status = 1;
+
+			const FString ModelPath(UTF8_TO_TCHAR(Control.ModelPath));
+			const FString PrePostProcessPath(UTF8_TO_TCHAR(Control.PrePostProcessPath));
+			const FString ChannelName(UTF8_TO_TCHAR(Control.ChannelName));
+
+			ov_compiled_model_t* CompiledModel = FindOrCompileModel(ModelPath, PrePostProcessPath);
+			FPlatformMemory::FSharedMemoryRegion* Region = CompiledModel && Control.ChannelSize >= sizeof(FChannelHeader)
+				? FPlatformMemory::MapNamedSharedMemoryRegion(ChannelName, false, ReadWrite, Control.ChannelSize) : nullptr;
+			FPlatformProcess::FSemaphore* RequestSemaphore = Region ? FPlatformProcess::NewInterprocessSynchObject(ChannelName + TEXT("_Req"), false, 1) : nullptr;
+			FPlatformProcess::FSemaphore* ResponseSemaphore = Region ? FPlatformProcess::NewInterprocessSynchObject(ChannelName + TEXT("_Resp"), false, 1) : nullptr;
+
+			ov_infer_request_t* InferRequest = nullptr;
+			bool bResult = RequestSemaphore && ResponseSemaphore && !ov_compiled_model_create_infer_request(CompiledModel, &InferRequest);
+
+			if (bResult)
+			{
+				FChannelHeader& Header = *(FChannelHeader*)Region->GetAddress();
+				bResult = FillTensorInfos(CompiledModel, true, Header.NumInputs, Header.Inputs) && FillTensorInfos(CompiledModel, false, Header.NumOutputs, Header.Outputs);
+			}
+
+			if (bResult)
+			{
+				TUniquePtr<FChannel>& Channel = Channels.Add_GetRef(MakeUnique<FChannel>(GetModelKey(ModelPath, PrePostProcessPath), ProcessId, InferRequest, Region, RequestSemaphore, ResponseSemaphore));
+				Channel->Start(TEXT("OpenVINODaemon_") + ChannelName);
+				Control.Status = 0;
+			}
+			else
+			{
+				if (InferRequest)
+				{
+					ov_infer_request_free(InferRequest);
+				}
+				DeleteSemaphore(RequestSemaphore);
+				DeleteSemaphore(ResponseSemaphore);
+				UnmapRegion(Region);
+				UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Daemon failed to open channel %s."), *ChannelName);
+			}
+
+			Control.ResponseId = RequestId;
+			ControlResponse->Unlock();
+		}
+
+		ov_core_t& OVCore;
+		FString Name;
+		FPlatformMemory::FSharedMemoryRegion* ControlRegion = nullptr;
+		FPlatformProcess::FSemaphore* ControlLock = nullptr;
+		FPlatformProcess::FSemaphore* ControlRequest = nullptr;
+		FPlatformProcess::FSemaphore* ControlResponse = nullptr;
+		FRunnableThread* Thread = nullptr;
+		std::atomic<bool> bStopping{ false };
+		TMap<FString, ov_compiled_model_t*> CompiledModels;
+		TArray<TUniquePtr<FChannel>> Channels;
+	};
+
+	TUniquePtr<FDaemon> RunningDaemon;
+}
+
+using namespace UE::NNERuntimeOpenVINO::Daemon::Private;
+
+void StartInferenceDaemon(ov_core_t& OVCore)
+{
+	if (!IsDaemonProcess() || !SupportsDevice(OVCore, TEXT("CPU")))
+	{
+		return;
+	}
+
+	RunningDaemon = MakeUnique<FDaemon>(OVCore);
+	if (!RunningDaemon->Start())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to start the OpenVINO inference daemon %s."), *GetDaemonName());
+		RunningDaemon.Reset();
+		return;
+	}
+
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("OpenVINO inference daemon %s started."), *GetDaemonName());
+}
+
+void StopInferenceDaemon()
+{
+	RunningDaemon.Reset();
+}
+
+bool ShouldUseInferenceDaemon()
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	return Settings && Settings->bUseInferenceDaemon && !IsDaemonProcess();
+}
+
+TSharedPtr<FOpenVINODaemonClient> FOpenVINODaemonClient::Connect(TSharedRef<UE::NNE::FSharedModelData> ModelData, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing, TArray<UE::NNE::FTensorDesc>& OutInputDescs, TArray<UE::NNE::FTensorDesc>& OutOutputDescs)
+{
+	FOpenVINOModelView ModelView;
+	FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	if (!OVModule || !ParseModelData(ModelData->GetView(), ModelView))
+	{
+		return {};
+	}
+
+	const FString Name = GetDaemonName();
+	FPlatformMemory::FSharedMemoryRegion* ControlRegion = FPlatformMemory::MapNamedSharedMemoryRegion(Name + TEXT("_Control"), false, ReadWrite, sizeof(FControlBlock));
+	if (!ControlRegion)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("No OpenVINO inference daemon named %s is running."), *Name);
+		return {};
+	}
+
+	FControlBlock& Control = *(FControlBlock*)ControlRegion->GetAddress();
+	FPlatformProcess::FSemaphore* ControlLock = FPlatformProcess::NewInterprocessSynchObject(Name + TEXT("_Lock"), false, 1);
+	FPlatformProcess::FSemaphore* ControlRequest = FPlatformProcess::NewInterprocessSynchObject(Name + TEXT("_Request"), false, 1);
+	FPlatformProcess::FSemaphore* ControlResponse = FPlatformProcess::NewInterprocessSynchObject(Name + TEXT("_Response"), false, 1);
+
+	ON_SCOPE_EXIT
+	{
+		DeleteSemaphore(ControlLock);
+		DeleteSemaphore(ControlRequest);
+		DeleteSemaphore(ControlResponse);
+		UnmapRegion(ControlRegion);
+	};
+
+	if (!ControlLock || !ControlRequest || !ControlResponse || Control.Magic != Magic || Control.Version != ProtocolVersion || !DecompressModelData(ModelView))
+	{
+		return {};
+	}
+
+	FString ModelPath;
+	FString WeightsPath;
+	const FBlake3Hash ContentHash = FNNERuntimeOpenVINO::HashModel(ModelView);
+	if (!OVModule->StageModelFiles(ModelView, ContentHash, GetModelDirectory(), ModelPath, WeightsPath))
+	{
+		return {};
+	}
+
+	// The pre and postprocessing are staged next to the model, named by the key of the processed model like the model is by its content.
+	FString PrePostProcessPath;
+	const FString PrePostProcessText = ExportPrePostProcessing(PrePostProcessing);
+	if (!PrePostProcessText.IsEmpty())
+	{
+		const FString Filename = FPaths::Combine(GetModelDirectory(), LexToString(GetProcessedModelKey(ContentHash, HashPrePostProcessing(PrePostProcessing))) + TEXT(".prepost"));
+		if (!IFileManager::Get().FileExists(*Filename) && !FFileHelper::SaveStringToFile(PrePostProcessText, *Filename))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to stage the pre and postprocessing in %s."), *Filename);
+			return {};
+		}
+
+		PrePostProcessPath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*Filename);
+	}
+
+	static std::atomic<uint32> ChannelCounter{ 0 };
+	const FString ChannelName = FString::Printf(TEXT("%s_%u_%u"), *Name, FPlatformProcess::GetCurrentProcessId(), ChannelCounter++);
+
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	const uint64 ChannelSize = FMath::Max<uint64>(Settings ? Settings->InferenceDaemonChannelMB : 0, 1) * 1024 * 1024;
+
+	TSharedPtr<FOpenVINODaemonClient> Client(new FOpenVINODaemonClient());
+	Client->Region = FPlatformMemory::MapNamedSharedMemoryRegion(ChannelName, true, ReadWrite, ChannelSize);
+	Client->RequestSemaphore = CreateSignal(ChannelName + TEXT("_Req"));
+	Client->ResponseSemaphore = CreateSignal(ChannelName + TEXT("_Resp"));
+	if (!Client->Region || !Client->RequestSemaphore || !Client->ResponseSemaphore)
+	{
+		return {};
+	}
+
+	FChannelHeader& Header = *(FChannelHeader*)Client->Region->GetAddress();
+	FMemory::Memzero(Header);
+	Header.Magic = Magic;
+	Header.Version = ProtocolVersion;
+
+	if (!ControlLock->TryLock(RegisterTimeoutNanoseconds))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Timed out waiting for the OpenVINO inference daemon %s."), *Name);
+		return {};
+	}
+
+	const uint64 RequestId = ((uint64)FPlatformProcess::GetCurrentProcessId() << 32) | ChannelCounter;
+	Control.RequestId = RequestId;
+	FCStringAnsi::Strncpy(Control.ModelPath, TCHAR_TO_UTF8(*ModelPath), MaxPath);
+	FCStringAnsi::Strncpy(Control.PrePostProcessPath, TCHAR_TO_UTF8(*PrePostProcessPath), MaxPath);
+	FCStringAnsi::Strncpy(Control.ChannelName, TCHAR_TO_UTF8(*ChannelName), MaxName);
+	Control.ChannelSize = ChannelSize;
+	Control.ProcessId = FPlatformProcess::GetCurrentProcessId();
+	ControlRequest->Unlock();
+
+	// A response meant for a client that timed out earlier can still be pending, skip it.
+	bool bRegistered = false;
+	while (ControlResponse->TryLock(RegisterTimeoutNanoseconds))
+	{
+		if (Control.ResponseId == RequestId)
+		{
+			bRegistered = Control.Status == 0;
+			break;
+		}
+	}
+
+	ControlLock->Unlock();
+
+	if (!bRegistered)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("The OpenVINO inference daemon %s couldn't load %s."), *Name, *ModelPath);
+		return {};
+	}
+
+	auto MakeDescs = [](const FTensorInfo* Infos, int32 Num, TArray<UE::NNE::FTensorDesc>& OutDescs)
+	{
+		OutDescs.Reset();
+		for (int32 i = 0; i < Num; ++i)
+		{
+			TArray<int32> SymbolicShape;
+			for (int32 j = 0; j < Infos[i].Rank; ++j)
+			{
+				SymbolicShape.Add((int32)Infos[i].Dims[j]);
+			}
+
+			OutDescs.Add(UE::NNE::FTensorDesc::Make("", UE::NNE::FSymbolicTensorShape::Make(SymbolicShape), OpenVINOTypeToNNEType((ov_element_type_e)Infos[i].ElementType)));
+		}
+	};
+
+	MakeDescs(Header.Inputs, Header.NumInputs, OutInputDescs);
+	MakeDescs(Header.Outputs, Header.NumOutputs, OutOutputDescs);
+	Client->InputDescs = OutInputDescs;
+
+	return Client;
+}
+
+FOpenVINODaemonClient::~FOpenVINODaemonClient()
+{
+	if (Region && RequestSemaphore)
+	{
+		((FChannelHeader*)Region->GetAddress())->bClosed = 1;
+		RequestSemaphore->Unlock();
+	}
+
+	DeleteSemaphore(RequestSemaphore);
+	DeleteSemaphore(ResponseSemaphore);
+	UnmapRegion(Region);
+}
+
+UE::NNE::EResultStatus FOpenVINODaemonClient::Run(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, TConstArrayView<UE::NNE::FTensorShape> InInputShapes, TArray<UE::NNE::FTensorShape>& OutOutputShapes)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FChannelHeader& Header = *(FChannelHeader*)Region->GetAddress();
+	if (bBroken || InInputTensors.Num() != Header.NumInputs || InOutputTensors.Num() > Header.NumOutputs)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Input/Output tensors are not set up properly."));
+		return UE::NNE::EResultStatus::Fail;
+	}
+
+	uint8* Base = (uint8*)Region->GetAddress();
+	uint64 Offset = Align(sizeof(FChannelHeader), DataAlignment);
+
+	for (int32 i = 0; i < InInputTensors.Num(); ++i)
+	{
+		FTensorInfo& Info = Header.Inputs[i];
+
+		// Shapes set with SetInputTensorShapes take precedence over static ones from the model.
+		TArray<uint32, TInlineAllocator<MaxRank>> Shape;
+		if (InInputShapes.IsValidIndex(i))
+		{
+			Shape.Append(InInputShapes[i].GetData());
+		}
+		else if (InputDescs[i].GetShape().IsConcrete())
+		{
+			Shape.Append(UE::NNE::FTensorShape::MakeFromSymbolic(InputDescs[i].GetShape()).GetData());
+		}
+		else
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Input shape [%d] must be set before running the model."), i);
+			return UE::NNE::EResultStatus::Fail;
+		}
+
+		if (Shape.Num() > MaxRank)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Input tensor [%d] has more than %d dimensions."), i, MaxRank);
+			return UE::NNE::EResultStatus::Fail;
+		}
+
+		// The daemon checks this too, but it serves every process on the host and shouldn't be handed bad requests.
+		const uint64 NeededSize = UE::NNE::FTensorShape::Make(Shape).Volume() * InputDescs[i].GetElementByteSize();
+		if (NeededSize > InInputTensors[i].SizeInBytes)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Input tensor [%d] needs %llu bytes for its shape but only %llu were provided."), i, NeededSize, (uint64)InInputTensors[i].SizeInBytes);
+			return UE::NNE::EResultStatus::Fail;
+		}
+
+		Info.Rank = Shape.Num();
+		for (int32 j = 0; j < Shape.Num(); ++j)
+		{
+			Info.Dims[j] = Shape[j];
+		}
+
+		Info.Offset = Offset;
+		Info.Size = InInputTensors[i].SizeInBytes;
+		Offset = Align(Offset + Info.Size, DataAlignment);
+	}
+
+	// Every output is described on each call, so nothing from a previous request is taken for a binding.
+	for (int32 i = 0; i < Header.NumOutputs; ++i)
+	{
+		Header.Outputs[i].Offset = Offset;
+		Header.Outputs[i].Size = i < InOutputTensors.Num() ? InOutputTensors[i].SizeInBytes : 0;
+		Offset = Align(Offset + Header.Outputs[i].Size, DataAlignment);
+	}
+
+	if (Offset > Region->GetSize())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Tensors need %llu bytes but the daemon channel only has %llu, raise InferenceDaemonChannelMB."), Offset, (uint64)Region->GetSize());
+		return UE::NNE::EResultStatus::Fail;
+	}
+
+	for (int32 i = 0; i < InInputTensors.Num(); ++i)
+	{
+		FMemory::Memcpy(Base + Header.Inputs[i].Offset, InInputTensors[i].Data, InInputTensors[i].SizeInBytes);
+	}
+
+	RequestSemaphore->Unlock();
+	if (!ResponseSemaphore->TryLock(InferTimeoutNanoseconds))
+	{
+		// The channel can't be trusted once a response is late, it might arrive during the next request.
+		bBroken = true;
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The OpenVINO inference daemon didn't respond."));
+		return UE::NNE::EResultStatus::Fail;
+	}
+
+	if (Header.Status != 0)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The OpenVINO inference daemon failed to execute the request."));
+		return UE::NNE::EResultStatus::Fail;
+	}
+
+	for (int32 i = 0; i < InOutputTensors.Num(); ++i)
+	{
+		if (Header.Outputs[i].Size > InOutputTensors[i].SizeInBytes)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Output tensor [%d] needs %llu bytes but only %llu were provided."), i, Header.Outputs[i].Size, (uint64)InOutputTensors[i].SizeInBytes);
+			return UE::NNE::EResultStatus::Fail;
+		}
+
+		FMemory::Memcpy(InOutputTensors[i].Data, Base + Header.Outputs[i].Offset, Header.Outputs[i].Size);
+	}
+
+	// The daemon writes back the shape of each output it returned, which may only be known after inference.
+	if (InOutputTensors.Num() == Header.NumOutputs)
+	{
+		OutOutputShapes.Reset(Header.NumOutputs);
+		for (int32 i = 0; i < Header.NumOutputs; ++i)
+		{
+			const FTensorInfo& Info = Header.Outputs[i];
+			TArray<uint32, TInlineAllocator<MaxRank>> Shape;
+			for (int32 j = 0; j < FMath::Clamp(Info.Rank, 0, MaxRank); ++j)
+			{
+				Shape.Add((uint32)Info.Dims[j]);
+			}
+			OutOutputShapes.Add(UE::NNE::FTensorShape::Make(Shape));
+		}
+	}
+
+	return UE::NNE::EResultStatus::Ok;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "NNERuntimeCPU.h"
+#include "NNETypes.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "openvino/c/ov_core.h"
+THIRD_PARTY_INCLUDES_END
+
+struct FNNERuntimeOpenVINOInstanceOptions;
+
+/**
+ * Out-of-process inference for hosts running many game processes.
+ *
+ * One process started with -OpenVINODaemon owns the OpenVINO core and the compiled models. The others stage their
+ * models in the shared model directory and register them over a control block in named shared memory. Each model
+ * instance gets its own channel: a shared memory region holding the tensor descriptions and data, and a pair of
+ * interprocess semaphores to hand requests to the daemon and results back.
+ */
+namespace UE::NNERuntimeOpenVINO::Daemon
+{
+	constexpr uint32 Magic = 0x4F564E44; // 'OVND'
+	constexpr uint32 ProtocolVersion = 3;
+	constexpr int32 MaxTensors = 16;
+	constexpr int32 MaxRank = 8;
+	constexpr int32 MaxPath = 1024;
+	constexpr int32 MaxName = 128;
+
+	struct FTensorInfo
+	{
+		int32 ElementType;
+		int32 Rank;
+		int64 Dims[MaxRank];
+		uint64 Offset;
+		uint64 Size;
+	};
+
+	/**
+	 * Start of every channel region, tensor data follows at the offsets given per tensor.
+	 * Requests describe every output, those the client didn't bind have a Size of 0 and are skipped.
+	 */
+	struct FChannelHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 Status;
+		int32 bClosed;
+		int32 NumInputs;
+		int32 NumOutputs;
+		FTensorInfo Inputs[MaxTensors];
+		FTensorInfo Outputs[MaxTensors];
+	};
+
+	/** Registration slot, only touched by the client holding the control lock. */
+	struct FControlBlock
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint64 RequestId;
+		uint64 ResponseId;
+		char ModelPath[MaxPath];
+		/** File with the pre and postprocessing to build into the model, see ExportPrePostProcessing. Empty if none. */
+		char PrePostProcessPath[MaxPath];
+		char ChannelName[MaxName];
+		uint64 ChannelSize;
+		uint32 ProcessId;
+		int32 Status;
+	};
+}
+
+/** Starts serving other processes if this one was launched with -OpenVINODaemon. */
+void StartInferenceDaemon(ov_core_t& OVCore);
+void StopInferenceDaemon();
+
+/** Whether model instances should run in the daemon rather than in this process. */
+bool ShouldUseInferenceDaemon();
+
+/** A model instance running in the daemon, seen from the game process. */
+class FOpenVINODaemonClient
+{
+public:
+	/**
+	 * Stages the model and its pre and postprocessing, registers it with the daemon and fills the tensor descriptions.
+	 * Returns null if no daemon answers.
+	 */
+	static TSharedPtr<FOpenVINODaemonClient> Connect(TSharedRef<UE::NNE::FSharedModelData> ModelData, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing, TArray<UE::NNE::FTensorDesc>& OutInputDescs, TArray<UE::NNE::FTensorDesc>& OutOutputDescs);
+
+	~FOpenVINODaemonClient();
+
+	/** OutOutputShapes is set to the shapes the daemon returned when every output is bound, and left as it is otherwise. */
+	UE::NNE::EResultStatus Run(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors, TConstArrayView<UE::NNE::FTensorShape> InInputShapes, TArray<UE::NNE::FTensorShape>& OutOutputShapes);
+
+private:
+	FOpenVINODaemonClient() = default;
+
+	FCriticalSection Lock;
+	TArray<UE::NNE::FTensorDesc> InputDescs;
+	bool bBroken = false;
+	FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+	FPlatformProcess::FSemaphore* RequestSemaphore = nullptr;
+	FPlatformProcess::FSemaphore* ResponseSemaphore = nullptr;
+};
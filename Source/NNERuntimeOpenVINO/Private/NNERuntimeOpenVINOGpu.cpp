@@ -24,30 +24,38 @@
 
 #include "NNERuntimeOpenVINOGpu.h"
 
-#include "Memory/SharedBuffer.h"
 #include "NNE.h"
 #include "NNEModelData.h"
 #include "NNERuntimeOpenVINOCommon.h"
-#include "Serialization/MemoryWriter.h"
+#include "NNERuntimeOpenVINOMemoryBudget.h"
 
 #include "openvino/c/ov_prepostprocess.h"
 #include "openvino/c/ov_tensor.h"
 
 FGuid UNNERuntimeOpenVINOGpuBase::GUID = FGuid((int32)'O', (int32)'V', (int32)'_', (int32)'G');
-int32 UNNERuntimeOpenVINOGpuBase::Version = 0x00000001;
+int32 UNNERuntimeOpenVINOGpuBase::Version = 0x00000003;
 
 FModelInstanceOpenVINOGpu::~FModelInstanceOpenVINOGpu()
 {
+	if (BudgetHandle)
+	{
+		FNNERuntimeOpenVINOMemoryBudget::Get().Unregister(BudgetHandle);
+	}
+
+	if (InferRequest)
+	{
+		ov_infer_request_free(InferRequest);
+	}
+
 	if (CompiledModel)
 	{
 		ov_compiled_model_free(CompiledModel);
 	}
 }
 
-bool FModelInstanceOpenVINOGpu::Init(TSharedRef<UE::NNE::FSharedModelData> ModelData)
+bool FModelInstanceOpenVINOGpu::Init(TSharedRef<UE::NNE::FSharedModelData> ModelData, TSharedPtr<FOpenVINOModelDataSource> InModelDataSource, const FNNERuntimeOpenVINOInstanceOptions& InOptions, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest)
 {
-	FString DeviceName;
-
+	Options = ResolveInstanceOptions(InOptions, InModelDataSource.Get());
 	int32 NumGPUs = 0;
 	if (HasMultiGpu(NumGPUs))
 	{
@@ -70,7 +78,8 @@ bool FModelInstanceOpenVINOGpu::Init(TSharedRef<UE::NNE::FSharedModelData> Model
 		DeviceName = TEXT("GPU");
 	}
 
-	if (!InitModelInstance(ModelData, CompiledModel, DeviceName))
+	FBlake3Hash SharedKey;
+	if (!InitModelInstance(ModelData, CompiledModel, CompiledWeights, InferRequest, SharedKey, DeviceName, Options, AsyncRequest))
 	{
 		return false;
 	}
@@ -84,6 +93,13 @@ bool FModelInstanceOpenVINOGpu::Init(TSharedRef<UE::NNE::FSharedModelData> Model
 		CompiledModel = nullptr;
 	}
 
+	if (bResult)
+	{
+		ModelDataSource = InModelDataSource;
+
+		BudgetHandle = RegisterModelInstance(ModelData->GetView(), SharedKey, InputSymbolicTensors, OutputSymbolicTensors, CompiledModelLock, CompiledModel, CompiledWeights, InferRequest);
+	}
+
 	return bResult;
 }
 
@@ -109,7 +125,8 @@ TConstArrayView<UE::NNE::FTensorShape> FModelInstanceOpenVINOGpu::GetOutputTenso
 
 UE::NNE::EResultStatus FModelInstanceOpenVINOGpu::SetInputTensorShapes(TConstArrayView<UE::NNE::FTensorShape> InInputShapes)
 {
-	if (!CompiledModel)
+	// An evicted instance has no compiled model but keeps its model data to restore from.
+	if (!CompiledModel && !(ModelDataSource && ModelDataSource->IsValid()))
 	{
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid compiled model."));
 		return UE::NNE::EResultStatus::Fail;
@@ -132,31 +149,80 @@ UE::NNE::EResultStatus FModelInstanceOpenVINOGpu::SetInputTensorShapes(TConstArr
 	}
 
 	InputTensorShapes = InInputShapes;
+
+	// Output shapes are only known up front when the model's are concrete, which is what output regions take their extents from.
+	OutputTensorShapes.Reset(OutputSymbolicTensors.Num());
+	for (const UE::NNE::FTensorDesc& OutputDesc : OutputSymbolicTensors)
+	{
+		if (!OutputDesc.GetShape().IsConcrete())
+		{
+			OutputTensorShapes.Reset();
+			break;
+		}
+
+		OutputTensorShapes.Add(UE::NNE::FTensorShape::MakeFromSymbolic(OutputDesc.GetShape()));
+	}
+
 	return UE::NNE::EResultStatus::Ok;
 }
 
 UE::NNE::EResultStatus FModelInstanceOpenVINOGpu::RunSync(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors)
 {
-	return ModelInfer(InInputTensors, InOutputTensors, CompiledModel);
+	return RunModelInstance(InInputTensors, InOutputTensors, ModelDataSource, CompiledModelLock, CompiledModel, CompiledWeights, InferRequest, DeviceName, Options, BudgetHandle);
+}
+
+UE::NNE::EResultStatus FModelInstanceOpenVINOGpu::RunSyncOnRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors)
+{
+	FScopeLock ScopeLock(&RegionScratchLock);
+
+	return RunOnTensorRegions(InInputTensors, InOutputTensors, InputSymbolicTensors, OutputSymbolicTensors, InputTensorShapes, OutputTensorShapes, RegionScratch,
+		[this](TConstArrayView<UE::NNE::FTensorBindingCPU> Inputs, TConstArrayView<UE::NNE::FTensorBindingCPU> Outputs)
+		{
+			return RunSync(Inputs, Outputs);
+		});
 }
 
-FModelOpenVINOGpu::FModelOpenVINOGpu(TSharedRef<UE::NNE::FSharedModelData> InModelData)
-	: ModelData(InModelData)
+FModelOpenVINOGpu::FModelOpenVINOGpu(TSharedRef<FOpenVINOModelDataSource> InModelDataSource)
+	: ModelDataSource(InModelDataSource)
 {
 }
 
 TSharedPtr<UE::NNE::IModelInstanceGPU> FModelOpenVINOGpu::CreateModelInstanceGPU()
 {
+	return CreateModelInstanceGPU(FNNERuntimeOpenVINOInstanceOptions());
+}
+
+TSharedPtr<UE::NNE::IModelInstanceGPU> FModelOpenVINOGpu::CreateModelInstanceGPU(const FNNERuntimeOpenVINOInstanceOptions& InOptions)
+{
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData = ModelDataSource->Get();
+
 	TSharedPtr<FModelInstanceOpenVINOGpu> ModelInstance = MakeShared<FModelInstanceOpenVINOGpu>();
-	if (!ModelInstance->Init(ModelData))
+	if (!ModelData || !ModelInstance->Init(ModelData.ToSharedRef(), ModelDataSource, InOptions))
 	{
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to initialize the model instance."));
 		return {};
 	}
 
+	ModelDataSource->ReleaseAfterCompile(TEXT("GPU"));
+
 	return ModelInstance;
 }
 
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> FModelOpenVINOGpu::CreateModelInstanceGPUAsync(FOnModelInstanceOpenVINOGpuCreated OnCreated, const UObject* Owner)
+{
+	return CreateModelInstanceGPUAsync(FNNERuntimeOpenVINOInstanceOptions(), MoveTemp(OnCreated), Owner);
+}
+
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> FModelOpenVINOGpu::CreateModelInstanceGPUAsync(const FNNERuntimeOpenVINOInstanceOptions& InOptions, FOnModelInstanceOpenVINOGpuCreated OnCreated, const UObject* Owner)
+{
+	TSharedRef<FNNERuntimeOpenVINOAsyncRequest> Request = CreateModelInstanceAsync<FModelInstanceOpenVINOGpu, UE::NNE::IModelInstanceGPU>(ModelDataSource, InOptions, MoveTemp(OnCreated), Owner);
+
+	// The task holds its own reference to the model data until it has compiled.
+	ModelDataSource->ReleaseAfterCompile(TEXT("GPU"));
+
+	return Request;
+}
+
 FString UNNERuntimeOpenVINOGpuBase::GetRuntimeName() const
 {
 	return TEXT("NNERuntimeOpenVINOGpu");
@@ -175,22 +241,12 @@ TSharedPtr<UE::NNE::FSharedModelData> UNNERuntimeOpenVINOGpuBase::CreateModelDat
 		return {};
 	}
 
-	bool bHasWeights = FileType.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0;
-
-	TArray64<uint8> WrappedFileData;
-	FMemoryWriter64 MemoryWriter(WrappedFileData);
-	MemoryWriter << bHasWeights;
-	MemoryWriter.Serialize((void*)FileData.GetData(), FileData.NumBytes());
-
-	FSharedBuffer SharedBuffer(FSharedBuffer::Clone(WrappedFileData.GetData(), WrappedFileData.NumBytes()));
-	
-	TSharedPtr<UE::NNE::FSharedModelData> SharedData(MakeShared<UE::NNE::FSharedModelData>(SharedBuffer, 0));
-	return SharedData;
+	return CreateOpenVINOModelData(FileType, FileData, AdditionalFileData, FileId, TEXT("GPU"), TargetPlatform);
 }
 
 FString UNNERuntimeOpenVINOGpuBase::GetModelDataIdentifier(const FString& FileType, TConstArrayView64<uint8> FileData, const TMap<FString, TConstArrayView64<uint8>>& AdditionalFileData, const FGuid& FileId, const ITargetPlatform* TargetPlatform) const
 {
-	return FileId.ToString(EGuidFormats::Digits) + "-" + UNNERuntimeOpenVINOGpu::GUID.ToString(EGuidFormats::Digits) + "-" + FString::FromInt(UNNERuntimeOpenVINOGpu::Version);
+	return FileId.ToString(EGuidFormats::Digits) + "-" + UNNERuntimeOpenVINOGpu::GUID.ToString(EGuidFormats::Digits) + "-" + FString::FromInt(UNNERuntimeOpenVINOGpu::Version) + GetModelDataIdentifierSuffix(FileType, FileId, TEXT("GPU"), TargetPlatform);
 }
 
 INNERuntimeGPU::ECanCreateModelGPUStatus UNNERuntimeOpenVINOGpu::CanCreateModelGPU(const TObjectPtr<UNNEModelData> ModelData) const
@@ -225,5 +281,5 @@ TSharedPtr<UE::NNE::IModelGPU> UNNERuntimeOpenVINOGpu::CreateModelGPU(const TObj
 	}
 
 	TSharedRef<UE::NNE::FSharedModelData> SharedData = ModelData->GetModelData(GetRuntimeName()).ToSharedRef();
-	return MakeShared<FModelOpenVINOGpu>(SharedData);
+	return MakeShared<FModelOpenVINOGpu>(MakeShared<FOpenVINOModelDataSource>(SharedData, ModelData, GetRuntimeName()));
 }
@@ -0,0 +1,714 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "NNERuntimeOpenVINOIRRewrite.h"
+
+#include "Math/Float16.h"
+#include "Math/RandomStream.h"
+#include "Misc/ScopeExit.h"
+#include "XmlFile.h"
+
+#include "NNERuntimeOpenVINOCommon.h"
+#include "NNERuntimeOpenVINOInstanceOptions.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "openvino/c/ov_compiled_model.h"
+#include "openvino/c/ov_infer_request.h"
+#include "openvino/c/ov_property.h"
+#include "openvino/c/ov_tensor.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UE::NNERuntimeOpenVINO::IR
+{
+	static void SetAttribute(FXmlNode* Node, const FString& Tag, const FString& Value)
+	{
+		TArray<FXmlAttribute> Attributes = Node->GetAttributes();
+		if (FXmlAttribute* Found = Attributes.FindByPredicate([&Tag](const FXmlAttribute& Attribute) { return Attribute.GetTag() == Tag; }))
+		{
+			*Found = FXmlAttribute(Tag, Value);
+		}
+		else
+		{
+			Attributes.Emplace(Tag, Value);
+		}
+		Node->SetAttributes(Attributes);
+	}
+
+	static FXmlNode* AppendChild(FXmlNode* Parent, const FString& Tag, const TArray<FXmlAttribute>& Attributes = {}, const FString& Content = FString())
+	{
+		Parent->AppendChildNode(Tag, Content, Attributes);
+		return Parent->GetChildrenNodes().Last();
+	}
+
+	static bool LoadXml(TConstArrayView64<uint8> FileData, FXmlFile& OutXml)
+	{
+		const FUTF8ToTCHAR Text((const ANSICHAR*)FileData.GetData(), (int32)FileData.Num());
+		if (!OutXml.LoadFile(FString(Text.Length(), Text.Get()), EConstructMethod::ConstructFromBuffer) || !OutXml.GetRootNode())
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to parse the IR model: %s"), *OutXml.GetLastError());
+			return false;
+		}
+		return true;
+	}
+
+	// Attributes and content are written back as FXmlFile read them, which is how FXmlFile::Save writes them too.
+	static void WriteXmlNode(const FXmlNode* Node, int32 Depth, FString& Out)
+	{
+		const FString Indent = FString::ChrN(Depth, TEXT('\t'));
+		Out += Indent + TEXT("<") + Node->GetTag();
+		for (const FXmlAttribute& Attribute : Node->GetAttributes())
+		{
+			Out += FString::Printf(TEXT(" %s=\"%s\""), *Attribute.GetTag(), *Attribute.GetValue());
+		}
+
+		if (Node->GetChildrenNodes().IsEmpty() && Node->GetContent().IsEmpty())
+		{
+			Out += TEXT("/>\n");
+			return;
+		}
+
+		if (Node->GetChildrenNodes().IsEmpty())
+		{
+			Out += TEXT(">") + Node->GetContent() + TEXT("</") + Node->GetTag() + TEXT(">\n");
+			return;
+		}
+
+		Out += TEXT(">\n");
+		for (const FXmlNode* Child : Node->GetChildrenNodes())
+		{
+			WriteXmlNode(Child, Depth + 1, Out);
+		}
+		Out += Indent + TEXT("</") + Node->GetTag() + TEXT(">\n");
+	}
+
+	// Written in memory, FXmlFile can only save to a file, and not necessarily as UTF-8.
+	static bool SaveXml(const FXmlFile& Xml, TArray64<uint8>& OutFileData)
+	{
+		FString Text(TEXT("<?xml version=\"1.0\"?>\n"));
+		WriteXmlNode(Xml.GetRootNode(), 0, Text);
+
+		const FTCHARToUTF8 Utf8(*Text);
+		OutFileData.Reset();
+		OutFileData.Append((const uint8*)Utf8.Get(), Utf8.Length());
+		return true;
+	}
+
+	static const TCHAR* GetElementType(ENNETensorDataType DataType)
+	{
+		switch (DataType)
+		{
+		case ENNETensorDataType::Boolean: return TEXT("boolean");
+		case ENNETensorDataType::Half: return TEXT("f16");
+		case ENNETensorDataType::BFloat16: return TEXT("bf16");
+		case ENNETensorDataType::Float: return TEXT("f32");
+		case ENNETensorDataType::Double: return TEXT("f64");
+		case ENNETensorDataType::Int8: return TEXT("i8");
+		case ENNETensorDataType::Int16: return TEXT("i16");
+		case ENNETensorDataType::Int32: return TEXT("i32");
+		case ENNETensorDataType::Int64: return TEXT("i64");
+		case ENNETensorDataType::UInt8: return TEXT("u8");
+		case ENNETensorDataType::UInt16: return TEXT("u16");
+		case ENNETensorDataType::UInt32: return TEXT("u32");
+		case ENNETensorDataType::UInt64: return TEXT("u64");
+		default: return nullptr;
+		}
+	}
+
+	// Tensor names are comma separated, with commas inside a name escaped.
+	static bool HasTensorName(const FString& Names, const FString& Name)
+	{
+		TArray<FString> SplitNames;
+		Names.Replace(TEXT("\\,"), TEXT("\x01")).ParseIntoArray(SplitNames, TEXT(","));
+		return SplitNames.ContainsByPredicate([&Name](const FString& TensorName) { return TensorName.TrimStartAndEnd().Replace(TEXT("\x01"), TEXT(",")) == Name; });
+	}
+
+	bool FreezeInputs(TConstArrayView64<uint8> FileData, TConstArrayView64<uint8> WeightsData, TConstArrayView<FNNERuntimeOpenVINOConstantInput> Inputs, TArray64<uint8>& OutFileData, TArray64<uint8>& OutWeightsData)
+	{
+		FXmlFile Xml;
+		if (!LoadXml(FileData, Xml))
+		{
+			return false;
+		}
+
+		FXmlNode* Layers = Xml.GetRootNode()->FindChildNode(TEXT("layers"));
+		if (!Layers)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The IR model has no layers."));
+			return false;
+		}
+
+		// The constants go after the existing weights, which keep their offsets.
+		OutWeightsData.Reset(Align(WeightsData.Num(), 64) + Inputs.Num() * 64);
+		OutWeightsData.Append(WeightsData.GetData(), WeightsData.Num());
+
+		for (const FNNERuntimeOpenVINOConstantInput& Input : Inputs)
+		{
+			FXmlNode* const* Found = Layers->GetChildrenNodes().FindByPredicate([&Input](const FXmlNode* Layer)
+			{
+				if (Layer->GetAttribute(TEXT("type")) != TEXT("Parameter"))
+				{
+					return false;
+				}
+
+				const FXmlNode* Output = Layer->FindChildNode(TEXT("output"));
+				const FXmlNode* Port = Output && !Output->GetChildrenNodes().IsEmpty() ? Output->GetChildrenNodes()[0] : nullptr;
+				return Layer->GetAttribute(TEXT("name")) == Input.Name || (Port && HasTensorName(Port->GetAttribute(TEXT("names")), Input.Name));
+			});
+
+			if (!Found)
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The model has no input %s to freeze."), *Input.Name);
+				return false;
+			}
+
+			const TCHAR* ElementType = GetElementType(Input.DataType);
+			const int64 Size = (int64)Input.Shape.Volume() * UE::NNE::GetTensorDataTypeSizeInBytes(Input.DataType);
+			if (!ElementType || Size != Input.Data.Num())
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The value of input %s doesn't match its shape and type."), *Input.Name);
+				return false;
+			}
+
+			const int64 Offset = Align(OutWeightsData.Num(), 64);
+			OutWeightsData.SetNumZeroed(Offset);
+			OutWeightsData.Append(Input.Data.GetData(), Input.Data.Num());
+
+			TArray<FString> Dims;
+			for (uint32 Dim : Input.Shape.GetData())
+			{
+				Dims.Add(LexToString(Dim));
+			}
+
+			FXmlNode* Layer = *Found;
+			SetAttribute(Layer, TEXT("type"), TEXT("Const"));
+			SetAttribute(Layer, TEXT("version"), TEXT("opset1"));
+
+			FXmlNode* Data = Layer->FindChildNode(TEXT("data"));
+			if (!Data)
+			{
+				Data = AppendChild(Layer, TEXT("data"));
+			}
+			Data->SetAttributes({ FXmlAttribute(TEXT("element_type"), ElementType), FXmlAttribute(TEXT("shape"), FString::Join(Dims, TEXT(","))),
+				FXmlAttribute(TEXT("offset"), LexToString(Offset)), FXmlAttribute(TEXT("size"), LexToString(Size)) });
+
+			// Dynamic dimensions of the output become the ones of the value, the layers it feeds are inferred again when read.
+			FXmlNode* Output = Layer->FindChildNode(TEXT("output"));
+			FXmlNode* Port = Output && !Output->GetChildrenNodes().IsEmpty() ? Output->GetChildrenNodes()[0] : nullptr;
+			if (!Port)
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Input %s has no output port in the IR model."), *Input.Name);
+				return false;
+			}
+
+			TArray<FXmlAttribute> PortAttributes;
+			for (const FXmlAttribute& Attribute : Port->GetAttributes())
+			{
+				if (Attribute.GetTag() != TEXT("precision"))
+				{
+					PortAttributes.Add(Attribute);
+				}
+			}
+
+			Output->DeleteChildNode(Port);
+			Port = AppendChild(Output, TEXT("port"), PortAttributes);
+			for (const FString& Dim : Dims)
+			{
+				AppendChild(Port, TEXT("dim"), {}, Dim);
+			}
+		}
+
+		return SaveXml(Xml, OutFileData);
+	}
+
+	bool PruneOutputs(TConstArrayView64<uint8> FileData, TConstArrayView<FString> Outputs, TArray64<uint8>& OutFileData)
+	{
+		FXmlFile Xml;
+		if (!LoadXml(FileData, Xml))
+		{
+			return false;
+		}
+
+		FXmlNode* Layers = Xml.GetRootNode()->FindChildNode(TEXT("layers"));
+		FXmlNode* Edges = Xml.GetRootNode()->FindChildNode(TEXT("edges"));
+		if (!Layers || !Edges)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The IR model has no layers or edges."));
+			return false;
+		}
+
+		TMap<FString, const FXmlNode*> LayersById;
+		for (const FXmlNode* Layer : Layers->GetChildrenNodes())
+		{
+			LayersById.Add(Layer->GetAttribute(TEXT("id")), Layer);
+		}
+
+		// An output is named after the tensor feeding its Result.
+		auto GetProducerPortNames = [&LayersById](const FXmlNode* Edge)
+		{
+			const FXmlNode* const* Producer = LayersById.Find(Edge->GetAttribute(TEXT("from-layer")));
+			const FXmlNode* Output = Producer ? (*Producer)->FindChildNode(TEXT("output")) : nullptr;
+			if (Output)
+			{
+				for (const FXmlNode* Port : Output->GetChildrenNodes())
+				{
+					if (Port->GetAttribute(TEXT("id")) == Edge->GetAttribute(TEXT("from-port")))
+					{
+						return Port->GetAttribute(TEXT("names"));
+					}
+				}
+			}
+			return FString();
+		};
+
+		TArray<FString> FoundOutputs;
+		TSet<FString> RemovedResults;
+		for (const FXmlNode* Layer : Layers->GetChildrenNodes())
+		{
+			if (Layer->GetAttribute(TEXT("type")) != TEXT("Result"))
+			{
+				continue;
+			}
+
+			const FString Id = Layer->GetAttribute(TEXT("id"));
+			FXmlNode* const* Edge = Edges->GetChildrenNodes().FindByPredicate([&Id](const FXmlNode* Candidate) { return Candidate->GetAttribute(TEXT("to-layer")) == Id; });
+			const FString Names = Edge ? GetProducerPortNames(*Edge) : FString();
+
+			const FString* Kept = Outputs.FindByPredicate([Layer, &Names](const FString& Output) { return Layer->GetAttribute(TEXT("name")) == Output || HasTensorName(Names, Output); });
+			if (Kept)
+			{
+				FoundOutputs.AddUnique(*Kept);
+			}
+			else
+			{
+				RemovedResults.Add(Id);
+			}
+		}
+
+		for (const FString& Output : Outputs)
+		{
+			if (!FoundOutputs.Contains(Output))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The model has no output %s."), *Output);
+				return false;
+			}
+		}
+
+		// Layers no Result depends on anymore are dropped by OpenVINO when it reads the model.
+		for (FXmlNode* Edge : TArray<FXmlNode*>(Edges->GetChildrenNodes()))
+		{
+			if (RemovedResults.Contains(Edge->GetAttribute(TEXT("to-layer"))))
+			{
+				Edges->DeleteChildNode(Edge);
+			}
+		}
+
+		for (FXmlNode* Layer : TArray<FXmlNode*>(Layers->GetChildrenNodes()))
+		{
+			if (RemovedResults.Contains(Layer->GetAttribute(TEXT("id"))))
+			{
+				Layers->DeleteChildNode(Layer);
+			}
+		}
+
+		return SaveXml(Xml, OutFileData);
+	}
+
+#if WITH_EDITOR
+
+	// Set by OpenVINO on nodes that must stay in FP32, e.g. precision sensitive subgraphs marked when the model was converted.
+	static bool IsFp16CompressionDisabled(const FXmlNode* Layer)
+	{
+		const FXmlNode* RtInfo = Layer ? Layer->FindChildNode(TEXT("rt_info")) : nullptr;
+		return RtInfo && RtInfo->GetChildrenNodes().ContainsByPredicate([](const FXmlNode* Attribute)
+		{
+			return Attribute->GetAttribute(TEXT("name")) == TEXT("disable_fp16_compression");
+		});
+	}
+
+	// Like OpenVINO's compress_float_constants, a constant stays in FP32 when most of its values would overflow or flush
+	// to zero in FP16. Unlike it, a single overflowing value is enough, since it would be clamped to the FP16 maximum.
+	static bool FitsFp16(TArrayView<const float> Values)
+	{
+		constexpr float MaxFp16 = 65504.0f;
+		constexpr float MinFp16Subnormal = 5.9604645e-8f;
+		constexpr double KeepFp32Ratio = 0.75;
+
+		int64 NumOutOfRange = 0;
+		for (float Value : Values)
+		{
+			const float AbsValue = FMath::Abs(Value);
+			if (!FMath::IsFinite(Value) || AbsValue == 0.0f)
+			{
+				continue;
+			}
+
+			if (AbsValue > MaxFp16)
+			{
+				return false;
+			}
+
+			NumOutOfRange += AbsValue < MinFp16Subnormal ? 1 : 0;
+		}
+
+		return Values.IsEmpty() || (double)NumOutOfRange / Values.Num() < KeepFp32Ratio;
+	}
+
+	bool CompressWeightsToFp16(TConstArrayView64<uint8> FileData, TConstArrayView64<uint8> WeightsData, TArray64<uint8>& OutFileData, TArray64<uint8>& OutWeightsData, FFp16CompressionStats& OutStats)
+	{
+		OutStats = FFp16CompressionStats();
+		OutStats.OriginalWeightsBytes = WeightsData.Num();
+
+		FXmlFile Xml;
+		if (!LoadXml(FileData, Xml))
+		{
+			return false;
+		}
+
+		FXmlNode* Layers = Xml.GetRootNode()->FindChildNode(TEXT("layers"));
+		FXmlNode* Edges = Xml.GetRootNode()->FindChildNode(TEXT("edges"));
+		if (!Layers || !Edges)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The IR model has no layers or edges."));
+			return false;
+		}
+
+		int64 NextLayerId = 0;
+		for (const FXmlNode* Layer : Layers->GetChildrenNodes())
+		{
+			// Constants of subgraphs (Loop, TensorIterator, If) point into the same weights and aren't rewritten.
+			if (Layer->FindChildNode(TEXT("body")) || Layer->FindChildNode(TEXT("then_body")))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Skipping FP16 compression, the IR model has subgraphs."));
+				return false;
+			}
+
+			NextLayerId = FMath::Max<int64>(NextLayerId, FCString::Atoi64(*Layer->GetAttribute(TEXT("id"))) + 1);
+		}
+
+		TMap<FString, TArray<FXmlNode*>> EdgesFromLayer;
+		for (FXmlNode* Edge : Edges->GetChildrenNodes())
+		{
+			EdgesFromLayer.FindOrAdd(Edge->GetAttribute(TEXT("from-layer"))).Add(Edge);
+		}
+
+		TMap<FString, const FXmlNode*> LayersById;
+		for (const FXmlNode* Layer : Layers->GetChildrenNodes())
+		{
+			LayersById.Add(Layer->GetAttribute(TEXT("id")), Layer);
+		}
+
+		// A constant feeding a layer marked to stay in FP32 stays in FP32 too.
+		auto IsKeptInFp32 = [&EdgesFromLayer, &LayersById](const FXmlNode* Layer)
+		{
+			if (IsFp16CompressionDisabled(Layer))
+			{
+				return true;
+			}
+
+			const TArray<FXmlNode*>* ConstEdges = EdgesFromLayer.Find(Layer->GetAttribute(TEXT("id")));
+			return ConstEdges && ConstEdges->ContainsByPredicate([&LayersById](const FXmlNode* Edge)
+			{
+				const FXmlNode* const* Consumer = LayersById.Find(Edge->GetAttribute(TEXT("to-layer")));
+				return Consumer && IsFp16CompressionDisabled(*Consumer);
+			});
+		};
+
+		// Every constant is rewritten into the new weights, constants sharing data keep sharing it.
+		TMap<TPair<int64, int64>, TPair<int64, bool>> WrittenData;
+		OutWeightsData.Reset();
+		OutWeightsData.Reserve(WeightsData.Num());
+
+		const TArray<FXmlNode*> OriginalLayers = Layers->GetChildrenNodes();
+		for (FXmlNode* Layer : OriginalLayers)
+		{
+			FXmlNode* Data = Layer->FindChildNode(TEXT("data"));
+			if (Layer->GetAttribute(TEXT("type")) != TEXT("Const") || !Data)
+			{
+				continue;
+			}
+
+			const int64 Offset = FCString::Atoi64(*Data->GetAttribute(TEXT("offset")));
+			const int64 Size = FCString::Atoi64(*Data->GetAttribute(TEXT("size")));
+			if (Offset < 0 || Size < 0 || Offset + Size > WeightsData.Num())
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Constant %s is outside of the IR weights."), *Layer->GetAttribute(TEXT("name")));
+				return false;
+			}
+
+			// A constant without an output port has nothing to insert the Convert on, so it keeps its FP32 data.
+			FXmlNode* Output = Layer->FindChildNode(TEXT("output"));
+			FXmlNode* OutputPort = Output && !Output->GetChildrenNodes().IsEmpty() ? Output->GetChildrenNodes()[0] : nullptr;
+
+			const TArrayView<const float> Values((const float*)(WeightsData.GetData() + Offset), (int32)(Size / sizeof(float)));
+			bool bCompress = OutputPort && Data->GetAttribute(TEXT("element_type")) == TEXT("f32") && Size % sizeof(float) == 0
+				&& !IsKeptInFp32(Layer) && FitsFp16(Values);
+
+			TPair<int64, bool>* Written = WrittenData.Find({ Offset, Size });
+			if (Written && Written->Value != bCompress)
+			{
+				// Data shared with a constant of another type, keep this one as it is.
+				Written = nullptr;
+				bCompress = false;
+			}
+
+			if (!Written)
+			{
+				const int64 NewOffset = Align(OutWeightsData.Num(), 64);
+				OutWeightsData.SetNumZeroed(NewOffset);
+				if (bCompress)
+				{
+					for (float Value : Values)
+					{
+						const FFloat16 Half(Value);
+						OutWeightsData.Append((const uint8*)&Half.Encoded, sizeof(Half.Encoded));
+					}
+				}
+				else
+				{
+					OutWeightsData.Append(WeightsData.GetData() + Offset, Size);
+				}
+				Written = &WrittenData.Add({ Offset, Size }, { NewOffset, bCompress });
+			}
+
+			SetAttribute(Data, TEXT("offset"), LexToString(Written->Key));
+			if (!bCompress)
+			{
+				continue;
+			}
+
+			SetAttribute(Data, TEXT("element_type"), TEXT("f16"));
+			SetAttribute(Data, TEXT("size"), LexToString(Size / 2));
+
+			// The Convert takes over the constant's outputs, tensor names included.
+			const FString ConstId = Layer->GetAttribute(TEXT("id"));
+			const FString ConstPort = OutputPort->GetAttribute(TEXT("id"));
+			const FString ConvertId = LexToString(NextLayerId++);
+			const FString TensorNames = OutputPort->GetAttribute(TEXT("names"));
+
+			TArray<FXmlAttribute> PortAttributes = { FXmlAttribute(TEXT("id"), ConstPort), FXmlAttribute(TEXT("precision"), TEXT("FP16")) };
+			OutputPort->SetAttributes(PortAttributes);
+
+			FXmlNode* Convert = AppendChild(Layers, TEXT("layer"), { FXmlAttribute(TEXT("id"), ConvertId), FXmlAttribute(TEXT("name"), Layer->GetAttribute(TEXT("name")) + TEXT("/Decompress")), FXmlAttribute(TEXT("type"), TEXT("Convert")), FXmlAttribute(TEXT("version"), TEXT("opset1")) });
+			AppendChild(Convert, TEXT("data"), { FXmlAttribute(TEXT("destination_type"), TEXT("f32")) });
+			FXmlNode* RtInfo = AppendChild(Convert, TEXT("rt_info"));
+			AppendChild(RtInfo, TEXT("attribute"), { FXmlAttribute(TEXT("name"), TEXT("decompression")), FXmlAttribute(TEXT("version"), TEXT("0")) });
+
+			FXmlNode* ConvertInput = AppendChild(AppendChild(Convert, TEXT("input")), TEXT("port"), { FXmlAttribute(TEXT("id"), TEXT("0")), FXmlAttribute(TEXT("precision"), TEXT("FP16")) });
+			TArray<FXmlAttribute> ConvertOutputAttributes = { FXmlAttribute(TEXT("id"), TEXT("1")), FXmlAttribute(TEXT("precision"), TEXT("FP32")) };
+			if (!TensorNames.IsEmpty())
+			{
+				ConvertOutputAttributes.Emplace(TEXT("names"), TensorNames);
+			}
+			FXmlNode* ConvertOutput = AppendChild(AppendChild(Convert, TEXT("output")), TEXT("port"), ConvertOutputAttributes);
+
+			for (const FXmlNode* Dim : OutputPort->GetChildrenNodes())
+			{
+				AppendChild(ConvertInput, TEXT("dim"), {}, Dim->GetContent());
+				AppendChild(ConvertOutput, TEXT("dim"), {}, Dim->GetContent());
+			}
+
+			if (TArray<FXmlNode*>* ConstEdges = EdgesFromLayer.Find(ConstId))
+			{
+				for (FXmlNode* Edge : *ConstEdges)
+				{
+					SetAttribute(Edge, TEXT("from-layer"), ConvertId);
+					SetAttribute(Edge, TEXT("from-port"), TEXT("1"));
+				}
+			}
+
+			AppendChild(Edges, TEXT("edge"), { FXmlAttribute(TEXT("from-layer"), ConstId), FXmlAttribute(TEXT("from-port"), ConstPort), FXmlAttribute(TEXT("to-layer"), ConvertId), FXmlAttribute(TEXT("to-port"), TEXT("0")) });
+			++OutStats.NumCompressedConstants;
+		}
+
+		OutStats.CompressedWeightsBytes = OutWeightsData.Num();
+		return SaveXml(Xml, OutFileData);
+	}
+
+	bool MeasureOutputDeviation(ov_core_t& OVCore, const FOpenVINOModelView& Reference, const FOpenVINOModelView& Model, TConstArrayView<TArray64<uint8>> Inputs, double& OutMaxAbsDeviation, double& OutMeanAbsDeviation)
+	{
+		ov_compiled_model_t* CompiledModels[2] = {};
+		ov_infer_request_t* InferRequests[2] = {};
+		TArray<ov_tensor_t*> Tensors;
+		ON_SCOPE_EXIT
+		{
+			ReleaseTensors(Tensors);
+			for (int32 i = 0; i < 2; ++i)
+			{
+				if (InferRequests[i])
+				{
+					ov_infer_request_free(InferRequests[i]);
+				}
+				if (CompiledModels[i])
+				{
+					ov_compiled_model_free(CompiledModels[i]);
+				}
+			}
+		};
+
+		// Both run in FP32 so only the weights differ.
+		const FOpenVINOModelView* Views[2] = { &Reference, &Model };
+		for (int32 i = 0; i < 2; ++i)
+		{
+			ov_model_t* ReadModelResult = nullptr;
+			if (!ReadModel(OVCore, *Views[i], ReadModelResult))
+			{
+				return false;
+			}
+
+			const ov_status_e Status = ov_core_compile_model(&OVCore, ReadModelResult, "CPU", 2, &CompiledModels[i], ov_property_key_hint_inference_precision, "f32");
+			ov_model_free(ReadModelResult);
+			if (Status || ov_compiled_model_create_infer_request(CompiledModels[i], &InferRequests[i]))
+			{
+				return false;
+			}
+		}
+
+		size_t NumInputs = 0;
+		if (ov_compiled_model_inputs_size(CompiledModels[0], &NumInputs))
+		{
+			return false;
+		}
+
+		if (!Inputs.IsEmpty() && (size_t)Inputs.Num() != NumInputs)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Skipping the deviation measurement, the model has %d inputs but %d calibration inputs were given."), (int32)NumInputs, Inputs.Num());
+			return false;
+		}
+
+		FRandomStream RandomStream(0x4F56);
+		for (size_t i = 0; i < NumInputs; ++i)
+		{
+			ov_output_const_port_t* Port = nullptr;
+			if (ov_compiled_model_input_by_index(CompiledModels[0], i, &Port))
+			{
+				return false;
+			}
+
+			ov_partial_shape_t PartialShape{};
+			ov_shape_t Shape{};
+			ov_element_type_e ElementType{};
+			const bool bStatic = !ov_port_get_partial_shape(Port, &PartialShape) && !ov_partial_shape_is_dynamic(PartialShape)
+				&& !ov_partial_shape_to_shape(PartialShape, &Shape) && !ov_port_get_element_type(Port, &ElementType);
+			ov_partial_shape_free(&PartialShape);
+			ov_output_const_port_free(Port);
+
+			ov_tensor_t*& Tensor = Tensors.AddZeroed_GetRef();
+			const bool bCreated = bStatic && !ov_tensor_create(ElementType, Shape, &Tensor);
+			ov_shape_free(&Shape);
+
+			void* Data = nullptr;
+			size_t ByteSize = 0;
+			if (!bCreated || ov_tensor_data(Tensor, &Data) || ov_tensor_get_byte_size(Tensor, &ByteSize))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Skipping the deviation measurement, input %d has a dynamic shape."), (int32)i);
+				return false;
+			}
+
+			if (!Inputs.IsEmpty())
+			{
+				if ((uint64)Inputs[i].Num() != (uint64)ByteSize)
+				{
+					UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Skipping the deviation measurement, calibration input %d has %lld bytes but the input takes %llu."), (int32)i, Inputs[i].Num(), (uint64)ByteSize);
+					return false;
+				}
+				FMemory::Memcpy(Data, Inputs[i].GetData(), ByteSize);
+			}
+			else
+			{
+				FMemory::Memzero(Data, ByteSize);
+				if (ElementType == F32)
+				{
+					for (float& Value : TArrayView<float>((float*)Data, (int32)(ByteSize / sizeof(float))))
+					{
+						Value = RandomStream.GetFraction();
+					}
+				}
+			}
+
+			if (ov_infer_request_set_input_tensor_by_index(InferRequests[0], i, Tensor) || ov_infer_request_set_input_tensor_by_index(InferRequests[1], i, Tensor))
+			{
+				return false;
+			}
+		}
+
+		if (ov_infer_request_infer(InferRequests[0]) || ov_infer_request_infer(InferRequests[1]))
+		{
+			return false;
+		}
+
+		size_t NumOutputs = 0;
+		if (ov_compiled_model_outputs_size(CompiledModels[0], &NumOutputs))
+		{
+			return false;
+		}
+
+		OutMaxAbsDeviation = 0.0;
+		double SumAbsDeviation = 0.0;
+		int64 NumValues = 0;
+		for (size_t i = 0; i < NumOutputs; ++i)
+		{
+			ov_tensor_t* Outputs[2] = {};
+			ON_SCOPE_EXIT
+			{
+				for (ov_tensor_t* Output : Outputs)
+				{
+					if (Output)
+					{
+						ov_tensor_free(Output);
+					}
+				}
+			};
+
+			ov_element_type_e ElementTypes[2] = {};
+			size_t Sizes[2] = {};
+			void* Data[2] = {};
+			for (int32 j = 0; j < 2; ++j)
+			{
+				if (ov_infer_request_get_output_tensor_by_index(InferRequests[j], i, &Outputs[j]) || ov_tensor_get_element_type(Outputs[j], &ElementTypes[j])
+					|| ov_tensor_get_size(Outputs[j], &Sizes[j]) || ov_tensor_data(Outputs[j], &Data[j]))
+				{
+					return false;
+				}
+			}
+
+			if (ElementTypes[0] != F32 || ElementTypes[1] != F32 || Sizes[0] != Sizes[1])
+			{
+				continue;
+			}
+
+			for (size_t k = 0; k < Sizes[0]; ++k)
+			{
+				const double Deviation = FMath::Abs((double)((const float*)Data[0])[k] - (double)((const float*)Data[1])[k]);
+				OutMaxAbsDeviation = FMath::Max(OutMaxAbsDeviation, Deviation);
+				SumAbsDeviation += Deviation;
+			}
+			NumValues += Sizes[0];
+		}
+
+		OutMeanAbsDeviation = NumValues > 0 ? SumAbsDeviation / NumValues : 0.0;
+		return NumValues > 0;
+	}
+#endif
+}
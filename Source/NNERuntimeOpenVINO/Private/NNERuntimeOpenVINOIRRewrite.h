@@ -0,0 +1,73 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "openvino/c/ov_core.h"
+THIRD_PARTY_INCLUDES_END
+
+struct FNNERuntimeOpenVINOConstantInput;
+struct FOpenVINOModelView;
+
+/**
+ * Rewrites of OpenVINO IR models applied when cooking or creating model instances. The C API can read but not
+ * serialize or edit models, so these edit the IR XML directly and write a new weights file to go with it.
+ */
+namespace UE::NNERuntimeOpenVINO::IR
+{
+	/** Replaces the Parameters of the given inputs with Constants holding their value. */
+	bool FreezeInputs(TConstArrayView64<uint8> FileData, TConstArrayView64<uint8> WeightsData, TConstArrayView<FNNERuntimeOpenVINOConstantInput> Inputs, TArray64<uint8>& OutFileData, TArray64<uint8>& OutWeightsData);
+
+	/** Removes the Results of all outputs but the given ones. The weights are unchanged. */
+	bool PruneOutputs(TConstArrayView64<uint8> FileData, TConstArrayView<FString> Outputs, TArray64<uint8>& OutFileData);
+
+#if WITH_EDITOR
+	struct FFp16CompressionStats
+	{
+		int32 NumCompressedConstants = 0;
+		int64 OriginalWeightsBytes = 0;
+		int64 CompressedWeightsBytes = 0;
+	};
+
+	/**
+	 * Stores FP32 constants as FP16, each followed by a Convert back to FP32 marked for decompression, as OpenVINO's
+	 * compress_to_fp16 does. Constants with a value above the FP16 range, with most values below it, or marked with
+	 * disable_fp16_compression (directly or through a consumer) are kept as they are. Unlike OpenVINO, precision
+	 * sensitive subgraphs that weren't marked when the model was converted aren't detected.
+	 */
+	bool CompressWeightsToFp16(TConstArrayView64<uint8> FileData, TConstArrayView64<uint8> WeightsData, TArray64<uint8>& OutFileData, TArray64<uint8>& OutWeightsData, FFp16CompressionStats& OutStats);
+
+	/**
+	 * Runs both models on the CPU with the same inputs and compares their FP32 outputs. Inputs holds the raw data of
+	 * each input, seeded random values are used if it's empty.
+	 * Returns false if the models can't be run, e.g. because an input shape is dynamic or an input has the wrong size.
+	 */
+	bool MeasureOutputDeviation(ov_core_t& OVCore, const FOpenVINOModelView& Reference, const FOpenVINOModelView& Model, TConstArrayView<TArray64<uint8>> Inputs, double& OutMaxAbsDeviation, double& OutMeanAbsDeviation);
+#endif
+}
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "NNERuntimeOpenVINOMemoryBudget.h"
+
+#include "Misc/ScopeLock.h"
+
+#include "NNERuntimeOpenVINOCommon.h"
+#include "NNERuntimeOpenVINOSettings.h"
+
+DECLARE_MEMORY_STAT(TEXT("Resident Compiled Models"), STAT_OpenVINOResidentMemory, STATGROUP_NNERuntimeOpenVINO);
+DECLARE_MEMORY_STAT(TEXT("Memory Budget"), STAT_OpenVINOMemoryBudget, STATGROUP_NNERuntimeOpenVINO);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Compiled Model Evictions"), STAT_OpenVINOEvictions, STATGROUP_NNERuntimeOpenVINO);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Compiled Model Restores"), STAT_OpenVINORestores, STATGROUP_NNERuntimeOpenVINO);
+
+FNNERuntimeOpenVINOMemoryBudget& FNNERuntimeOpenVINOMemoryBudget::Get()
+{
+	static FNNERuntimeOpenVINOMemoryBudget MemoryBudget;
+	return MemoryBudget;
+}
+
+uint64 FNNERuntimeOpenVINOMemoryBudget::Register(int64 Footprint, const FBlake3Hash& SharedKey, int64 WeightsFootprint, TFunction<bool()> TryEvict)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const uint64 Handle = NextHandle++;
+
+	FEntry& Entry = Entries.Add(Handle);
+	Entry.Footprint = Footprint;
+	Entry.WeightsFootprint = WeightsFootprint;
+	Entry.SharedKey = SharedKey;
+	Entry.LastUsed = ++UseCounter;
+	Entry.TryEvict = MoveTemp(TryEvict);
+
+	AddResident(Entry);
+	SET_MEMORY_STAT(STAT_OpenVINOResidentMemory, ResidentBytes);
+
+	EnforceBudget(Handle);
+
+	return Handle;
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::Unregister(uint64 Handle)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(Handle, Entry) && Entry.bResident)
+	{
+		RemoveResident(Entry);
+		SET_MEMORY_STAT(STAT_OpenVINOResidentMemory, ResidentBytes);
+	}
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::Touch(uint64 Handle)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (FEntry* Entry = Entries.Find(Handle))
+	{
+		Entry->LastUsed = ++UseCounter;
+	}
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::MarkRestored(uint64 Handle)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FEntry* Entry = Entries.Find(Handle);
+	if (!Entry || Entry->bResident)
+	{
+		return;
+	}
+
+	Entry->LastUsed = ++UseCounter;
+	AddResident(*Entry);
+	SET_MEMORY_STAT(STAT_OpenVINOResidentMemory, ResidentBytes);
+	INC_DWORD_STAT(STAT_OpenVINORestores);
+
+	EnforceBudget(Handle);
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::MarkEvicted(uint64 Handle)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FEntry* Entry = Entries.Find(Handle);
+	if (Entry && Entry->bResident)
+	{
+		RemoveResident(*Entry);
+		SET_MEMORY_STAT(STAT_OpenVINOResidentMemory, ResidentBytes);
+	}
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::AddResident(FEntry& Entry)
+{
+	Entry.bResident = true;
+	ResidentBytes += Entry.Footprint;
+
+	if (Entry.SharedKey.IsZero() || SharedWeights.FindOrAdd(Entry.SharedKey)++ == 0)
+	{
+		ResidentBytes += Entry.WeightsFootprint;
+	}
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::RemoveResident(FEntry& Entry)
+{
+	Entry.bResident = false;
+	ResidentBytes -= Entry.Footprint;
+
+	if (Entry.SharedKey.IsZero())
+	{
+		ResidentBytes -= Entry.WeightsFootprint;
+	}
+	else if (int32* NumSharing = SharedWeights.Find(Entry.SharedKey); NumSharing && --(*NumSharing) == 0)
+	{
+		// The shared weights are only released with the last model using them.
+		SharedWeights.Remove(Entry.SharedKey);
+		ResidentBytes -= Entry.WeightsFootprint;
+	}
+}
+
+void FNNERuntimeOpenVINOMemoryBudget::EnforceBudget(uint64 ProtectedHandle)
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	const int64 Budget = Settings ? (int64)Settings->MemoryBudgetMB * 1024 * 1024 : 0;
+	SET_MEMORY_STAT(STAT_OpenVINOMemoryBudget, Budget);
+
+	if (Budget <= 0 || ResidentBytes <= Budget)
+	{
+		return;
+	}
+
+	TArray<TPair<uint64, FEntry*>> Candidates;
+	for (TPair<uint64, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.bResident && Pair.Key != ProtectedHandle)
+		{
+			Candidates.Emplace(Pair.Key, &Pair.Value);
+		}
+	}
+
+	Candidates.Sort([](const TPair<uint64, FEntry*>& A, const TPair<uint64, FEntry*>& B)
+	{
+		return A.Value->LastUsed < B.Value->LastUsed;
+	});
+
+	for (const TPair<uint64, FEntry*>& Candidate : Candidates)
+	{
+		if (ResidentBytes <= Budget)
+		{
+			break;
+		}
+
+		// Models running an inference are skipped, they'll be reconsidered the next time the budget is exceeded.
+		FEntry& Entry = *Candidate.Value;
+		if (Entry.TryEvict())
+		{
+			const int64 PreviousBytes = ResidentBytes;
+			RemoveResident(Entry);
+			INC_DWORD_STAT(STAT_OpenVINOEvictions);
+			UE_LOG(LogNNERuntimeOpenVINO, Verbose, TEXT("Evicted compiled model (%lld bytes) to stay within the memory budget."), PreviousBytes - ResidentBytes);
+		}
+	}
+
+	SET_MEMORY_STAT(STAT_OpenVINOResidentMemory, ResidentBytes);
+
+	if (ResidentBytes > Budget)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Verbose, TEXT("Compiled models use %lld bytes, over the %lld byte budget, because the rest are in use."), ResidentBytes, Budget);
+	}
+}
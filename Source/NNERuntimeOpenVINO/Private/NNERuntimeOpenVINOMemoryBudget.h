@@ -0,0 +1,77 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Hash/Blake3.h"
+
+/**
+ * Tracks the estimated memory of every compiled model against the configured budget.
+ * When the budget is exceeded, the least recently used idle models are evicted. An evicted model restores itself on next use.
+ */
+class FNNERuntimeOpenVINOMemoryBudget
+{
+public:
+	static FNNERuntimeOpenVINOMemoryBudget& Get();
+
+	/**
+	 * Starts tracking a resident compiled model. TryEvict is called with the budget lock held and must
+	 * release the compiled model without blocking, returning false if the model is in use.
+	 * The weights are counted once for all resident models registered with the same non-zero SharedKey.
+	 */
+	uint64 Register(int64 Footprint, const FBlake3Hash& SharedKey, int64 WeightsFootprint, TFunction<bool()> TryEvict);
+	void Unregister(uint64 Handle);
+
+	/** Marks the model as the most recently used one. */
+	void Touch(uint64 Handle);
+
+	void MarkRestored(uint64 Handle);
+	void MarkEvicted(uint64 Handle);
+
+private:
+	struct FEntry
+	{
+		int64 Footprint = 0;
+		int64 WeightsFootprint = 0;
+		FBlake3Hash SharedKey;
+		uint64 LastUsed = 0;
+		bool bResident = false;
+		TFunction<bool()> TryEvict;
+	};
+
+	void AddResident(FEntry& Entry);
+	void RemoveResident(FEntry& Entry);
+	void EnforceBudget(uint64 ProtectedHandle);
+
+	FCriticalSection Lock;
+	TMap<uint64, FEntry> Entries;
+
+	// Number of resident models sharing each set of weights.
+	TMap<FBlake3Hash, int32> SharedWeights;
+	uint64 NextHandle = 1;
+	uint64 UseCounter = 0;
+	int64 ResidentBytes = 0;
+};
@@ -0,0 +1,277 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "NNERuntimeOpenVINOModelFormat.h"
+
+#include "NNERuntimeOpenVINOCommon.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace UE::NNERuntimeOpenVINO::ModelFormat
+{
+	/** Fixed size so the table offset can be patched after the payloads are written. */
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		uint64 TableOffset = 0;
+		uint32 NumSections = 0;
+		uint32 Reserved[11] = {};
+	};
+	static_assert(sizeof(FHeader) == SectionAlignment, "The first section must start aligned.");
+
+	static uint64 GetAlignment(ESectionType Type)
+	{
+		return (Type == ESectionType::Weights || Type == ESectionType::ExternalData) ? PageAlignment : SectionAlignment;
+	}
+
+	bool IsContainer(TConstArrayView64<uint8> Data)
+	{
+		return Data.Num() >= (int64)sizeof(FHeader) && ((const FHeader*)Data.GetData())->Magic == Magic;
+	}
+
+	bool ReadSections(TConstArrayView64<uint8> Data, TArray<FSection>& OutSections)
+	{
+		OutSections.Reset();
+		if (!IsContainer(Data))
+		{
+			return false;
+		}
+
+		FHeader Header;
+		FMemory::Memcpy(&Header, Data.GetData(), sizeof(FHeader));
+		if (Header.Version > FormatVersion)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Model data format version %u is newer than the supported version %u."), Header.Version, FormatVersion);
+			return false;
+		}
+
+		if (Header.TableOffset < sizeof(FHeader) || Header.TableOffset > (uint64)Data.Num())
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid model data section table."));
+			return false;
+		}
+
+		FMemoryReaderView MemoryReader(Data);
+		MemoryReader.Seek(Header.TableOffset);
+
+		for (uint32 i = 0; i < Header.NumSections; ++i)
+		{
+			uint32 Type = 0;
+			uint64 Offset = 0;
+			uint64 Size = 0;
+
+			FSection& Section = OutSections.AddDefaulted_GetRef();
+			MemoryReader << Type;
+			MemoryReader << Section.Flags;
+			MemoryReader << Section.Name;
+			MemoryReader << Section.Version;
+			MemoryReader << Offset;
+			MemoryReader << Size;
+
+			if (MemoryReader.IsError() || Offset > Header.TableOffset || Size > Header.TableOffset - Offset)
+			{
+				OutSections.Reset();
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid model data section %u."), i);
+				return false;
+			}
+
+			Section.Type = (ESectionType)Type;
+			Section.Data = TConstArrayView64<uint8>(Data.GetData() + Offset, Size);
+		}
+
+		return true;
+	}
+
+	const FSection* FindSection(TConstArrayView<FSection> Sections, ESectionType Type)
+	{
+		return Sections.FindByPredicate([Type](const FSection& Section) { return Section.Type == Type; });
+	}
+
+	/** Prefix of a compressed payload, the chunks follow back to back. */
+	struct FCompressionHeader
+	{
+		FString FormatName;
+		int64 UncompressedSize = 0;
+		int32 ChunkSize = 0;
+		TArray<int32> CompressedChunkSizes;
+
+		friend FArchive& operator<<(FArchive& Ar, FCompressionHeader& Header)
+		{
+			return Ar << Header.FormatName << Header.UncompressedSize << Header.ChunkSize << Header.CompressedChunkSizes;
+		}
+	};
+
+	static bool ReadCompressionHeader(const FSection& Section, FCompressionHeader& OutHeader, int64& OutChunksOffset)
+	{
+		FMemoryReaderView MemoryReader(Section.Data);
+		MemoryReader << OutHeader;
+		OutChunksOffset = MemoryReader.Tell();
+
+		return !MemoryReader.IsError() && OutHeader.UncompressedSize >= 0 && OutHeader.ChunkSize > 0
+			&& OutHeader.CompressedChunkSizes.Num() == FMath::DivideAndRoundUp<int64>(OutHeader.UncompressedSize, OutHeader.ChunkSize);
+	}
+
+	int64 GetUncompressedSize(const FSection& Section)
+	{
+		if (!(Section.Flags & SectionFlag_Compressed))
+		{
+			return Section.Data.Num();
+		}
+
+		FCompressionHeader Header;
+		int64 ChunksOffset = 0;
+		return ReadCompressionHeader(Section, Header, ChunksOffset) ? Header.UncompressedSize : -1;
+	}
+
+	bool CompressSection(FSection& Section, FName FormatName, TArray64<uint8>& OutData)
+	{
+		if (Section.Flags & SectionFlag_Compressed || Section.Data.IsEmpty())
+		{
+			return false;
+		}
+
+		FCompressionHeader Header;
+		Header.FormatName = FormatName.ToString();
+		Header.UncompressedSize = Section.Data.Num();
+		Header.ChunkSize = CompressionChunkSize;
+
+		TArray64<uint8> Chunks;
+		TArray<uint8> CompressedChunk;
+		for (int64 Offset = 0; Offset < Section.Data.Num(); Offset += CompressionChunkSize)
+		{
+			const int32 ChunkSize = (int32)FMath::Min<int64>(CompressionChunkSize, Section.Data.Num() - Offset);
+			int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, ChunkSize);
+			CompressedChunk.SetNumUninitialized(CompressedSize);
+
+			if (!FCompression::CompressMemory(FormatName, CompressedChunk.GetData(), CompressedSize, Section.Data.GetData() + Offset, ChunkSize))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to compress model data with %s."), *Header.FormatName);
+				return false;
+			}
+
+			Header.CompressedChunkSizes.Add(CompressedSize);
+			Chunks.Append(CompressedChunk.GetData(), CompressedSize);
+		}
+
+		// Small gains aren't worth the decompression at load.
+		if (Chunks.Num() > Section.Data.Num() * 9 / 10)
+		{
+			return false;
+		}
+
+		OutData.Reset();
+		FMemoryWriter64 MemoryWriter(OutData);
+		MemoryWriter << Header;
+		OutData.Append(Chunks);
+
+		Section.Flags |= SectionFlag_Compressed;
+		Section.Data = OutData;
+		return true;
+	}
+
+	bool DecompressSection(const FSection& Section, TArrayView64<uint8> Destination)
+	{
+		FCompressionHeader Header;
+		int64 Offset = 0;
+		if (!(Section.Flags & SectionFlag_Compressed) || !ReadCompressionHeader(Section, Header, Offset) || Header.UncompressedSize != Destination.Num())
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid compressed model data section."));
+			return false;
+		}
+
+		const FName FormatName(*Header.FormatName);
+		for (int32 i = 0; i < Header.CompressedChunkSizes.Num(); ++i)
+		{
+			const int64 DestinationOffset = (int64)i * Header.ChunkSize;
+			const int32 ChunkSize = (int32)FMath::Min<int64>(Header.ChunkSize, Header.UncompressedSize - DestinationOffset);
+			const int32 CompressedSize = Header.CompressedChunkSizes[i];
+
+			if (CompressedSize <= 0 || Offset + CompressedSize > Section.Data.Num()
+				|| !FCompression::UncompressMemory(FormatName, Destination.GetData() + DestinationOffset, ChunkSize, Section.Data.GetData() + Offset, CompressedSize))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to decompress model data with %s."), *Header.FormatName);
+				return false;
+			}
+
+			Offset += CompressedSize;
+		}
+
+		return true;
+	}
+
+	FSharedBuffer WriteSections(TConstArrayView<FSection> Sections)
+	{
+		FHeader Header;
+		Header.Magic = Magic;
+		Header.Version = FormatVersion;
+		Header.NumSections = Sections.Num();
+
+		// Lay the container out first so it can be written in a single allocation.
+		TArray<uint64> Offsets;
+		uint64 Offset = sizeof(FHeader);
+		for (const FSection& Section : Sections)
+		{
+			Offset = Align(Offset, GetAlignment(Section.Type));
+			Offsets.Add(Offset);
+			Offset += Section.Data.Num();
+		}
+
+		Header.TableOffset = Offset;
+
+		TArray64<uint8> Table;
+		FMemoryWriter64 MemoryWriter(Table);
+		for (int32 i = 0; i < Sections.Num(); ++i)
+		{
+			uint32 Type = (uint32)Sections[i].Type;
+			uint32 Flags = Sections[i].Flags;
+			FString Name = Sections[i].Name;
+			FString Version = Sections[i].Version;
+			uint64 SectionOffset = Offsets[i];
+			uint64 Size = Sections[i].Data.Num();
+
+			MemoryWriter << Type;
+			MemoryWriter << Flags;
+			MemoryWriter << Name;
+			MemoryWriter << Version;
+			MemoryWriter << SectionOffset;
+			MemoryWriter << Size;
+		}
+
+		const uint64 TotalSize = Header.TableOffset + Table.Num();
+		uint8* Buffer = (uint8*)FMemory::Malloc(TotalSize, PageAlignment);
+		FMemory::Memzero(Buffer, Header.TableOffset);
+		FMemory::Memcpy(Buffer, &Header, sizeof(FHeader));
+
+		for (int32 i = 0; i < Sections.Num(); ++i)
+		{
+			FMemory::Memcpy(Buffer + Offsets[i], Sections[i].Data.GetData(), Sections[i].Data.Num());
+		}
+
+		FMemory::Memcpy(Buffer + Header.TableOffset, Table.GetData(), Table.Num());
+		return FSharedBuffer::TakeOwnership(Buffer, TotalSize, FMemory::Free);
+	}
+}
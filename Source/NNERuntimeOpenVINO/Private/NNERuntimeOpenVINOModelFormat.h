@@ -0,0 +1,105 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Memory/SharedBuffer.h"
+
+/**
+ * Container for cooked OpenVINO model data.
+ *
+ * A fixed header is followed by the section payloads and a section table. Every payload starts at an aligned
+ * offset from the start of the container, weights at a page boundary, so they can be used in place. Readers skip
+ * section types they don't know, new ones can be added without bumping the format version.
+ */
+namespace UE::NNERuntimeOpenVINO::ModelFormat
+{
+	constexpr uint32 Magic = 0x4D4E564F; // 'OVNM'
+	constexpr uint32 FormatVersion = 1;
+	constexpr uint64 SectionAlignment = 64;
+	constexpr uint64 PageAlignment = 4096;
+	constexpr int32 CompressionChunkSize = 256 * 1024;
+
+	/** The payload is split in chunks compressed with FCompression, see CompressSection. */
+	constexpr uint32 SectionFlag_Compressed = 1 << 0;
+
+	enum class ESectionType : uint32
+	{
+		/** The file type in Name and, since it's been stored, the content hash of the model in Version. */
+		Model = 1,
+		Weights = 2,
+		CompiledBlob = 3,
+		ShapeProfiles = 4,
+		/** No payload: the hash of the pre and postprocessing built into the compiled blobs in Version. */
+		PrePostProcess = 5,
+		Metadata = 6,
+		/** No payload: the model and weights are in the model data of the runtime in Name, with the content hash in Version. */
+		PayloadReference = 7,
+		/** An ONNX external data file, with its location relative to the model in Name. */
+		ExternalData = 8,
+	};
+
+	struct FSection
+	{
+		ESectionType Type = ESectionType::Metadata;
+		uint32 Flags = 0;
+		/** Meaning depends on the type, e.g. the file type of the model or the device of a compiled blob. */
+		FString Name;
+		/** E.g. the OpenVINO build a compiled blob was exported from. */
+		FString Version;
+		TConstArrayView64<uint8> Data;
+	};
+
+	/** Whether the data starts with a container header, older model data is a bare sequence of sizes and payloads. */
+	bool IsContainer(TConstArrayView64<uint8> Data);
+
+	/** Fills sections with views into the data, no payload is copied. */
+	bool ReadSections(TConstArrayView64<uint8> Data, TArray<FSection>& OutSections);
+
+	const FSection* FindSection(TConstArrayView<FSection> Sections, ESectionType Type);
+
+	/** Size of the payload once decompressed, or -1 if the compression header is invalid. */
+	int64 GetUncompressedSize(const FSection& Section);
+
+	/**
+	 * Compresses the payload into OutData, which the section then points to. Each chunk decompresses independently,
+	 * so loading never holds more than the compressed data and the destination buffer. Returns false and leaves
+	 * the section untouched if compression doesn't save enough to be worth the decompression at load.
+	 */
+	bool CompressSection(FSection& Section, FName FormatName, TArray64<uint8>& OutData);
+
+	/** Decompresses the payload chunk by chunk straight into Destination, which must hold GetUncompressedSize bytes. */
+	bool DecompressSection(const FSection& Section, TArrayView64<uint8> Destination);
+
+	/** Writes the sections into a new page aligned container, the payloads are copied once straight into place. */
+	FSharedBuffer WriteSections(TConstArrayView<FSection> Sections);
+
+	inline TConstArrayView64<uint8> MakeView(const FSharedBuffer& Buffer)
+	{
+		return TConstArrayView64<uint8>((const uint8*)Buffer.GetData(), Buffer.GetSize());
+	}
+}
@@ -28,17 +28,58 @@
 #include "NNERuntimeOpenVINONpu.h"
 #include "NNERuntimeOpenVINOGpu.h"
 #include "NNE.h"
+#include "NNEModelData.h"
 #include "NNERuntimeOpenVINOCommon.h"
+#include "NNERuntimeOpenVINODaemon.h"
+#include "NNERuntimeOpenVINOPreloader.h"
+#include "NNERuntimeOpenVINOSettings.h"
 
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
 #include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_MODULE(FNNERuntimeOpenVINO, NNERuntimeOpenVINO)
 
 DEFINE_LOG_CATEGORY(LogNNERuntimeOpenVINO);
 
+// Pages shared with other processes are counted in full by every process' resident size. The proportional
+// set size splits them between the processes mapping them, so summing it over all servers gives the host's real usage.
+static void LogMemoryReport()
+{
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Process memory: used physical %.1f MB, peak %.1f MB."),
+		MemoryStats.UsedPhysical / (1024.0 * 1024.0), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+
+#if PLATFORM_LINUX
+	FString SmapsRollup;
+	if (FFileHelper::LoadFileToString(SmapsRollup, TEXT("/proc/self/smaps_rollup")))
+	{
+		TArray<FString> Lines;
+		SmapsRollup.ParseIntoArrayLines(Lines);
+		for (const FString& Line : Lines)
+		{
+			if (Line.StartsWith(TEXT("Rss:")) || Line.StartsWith(TEXT("Pss:")) || Line.StartsWith(TEXT("Shared_Clean:")) || Line.StartsWith(TEXT("Private_Clean:")) || Line.StartsWith(TEXT("Private_Dirty:")))
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("  %s"), *Line);
+			}
+		}
+	}
+#endif
+}
+
+static FAutoConsoleCommand MemoryReportCommand(
+	TEXT("OpenVINO.MemoryReport"),
+	TEXT("Logs this process' memory use, including the pages it shares with other processes where the platform reports it."),
+	FConsoleCommandDelegate::CreateStatic(&LogMemoryReport));
+
 void FNNERuntimeOpenVINO::StartupModule()
 {
 	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Loaded NNERuntimeOpenVINO"));
@@ -67,6 +108,10 @@ void FNNERuntimeOpenVINO::StartupModule()
 	}
 
 	LogDevices();
+	SetupModelCache();
+	SetupWeightsMapping();
+	SetupSharedModels();
+	StartInferenceDaemon(*OVCore);
 
 #ifdef OPENVINO_CPU_PLUGIN
 	// NNE runtime ORT Cpu startup
@@ -145,15 +190,33 @@ void FNNERuntimeOpenVINO::StartupModule()
 #endif
 	}
 #endif
+
+	// Installers and launchers run the packaged game with -OpenVINOPrecompile to fill the cache on the player's machine.
+	if (FParse::Param(FCommandLine::Get(), TEXT("OpenVINOPrecompile")))
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FNNERuntimeOpenVINO::PrecompileAndExit);
+	}
 }
 
 void FNNERuntimeOpenVINO::ShutdownModule()
 {
+	StopInferenceDaemon();
+
+	{
+		FScopeLock Lock(&ModelRegistryLock);
+		ModelRegistry.Empty();
+	}
+
 	if (OVCore)
 	{
 		ov_core_free(OVCore);
 	}
 
+	if (bStagedTemporaryModels)
+	{
+		IFileManager::Get().DeleteDirectory(*FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OpenVINO"), TEXT("Temp"), LexToString(FPlatformProcess::GetCurrentProcessId())), false, true);
+	}
+
 #ifdef OPENVINO_GPU_PLUGIN
 	// NNE runtime ORT Gpu shutdown
 	if (NNERuntimeOpenVINOGpu.IsValid())
@@ -236,3 +299,545 @@ void FNNERuntimeOpenVINO::LogDevices()
 
 	ov_available_devices_free(&AvailableDevices);
 }
+
+void FNNERuntimeOpenVINO::SetupModelCache()
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!Settings || !Settings->bEnableModelCache || Settings->CacheDirectory.IsEmpty())
+	{
+		return;
+	}
+
+	CacheDirectory = FPaths::IsRelative(Settings->CacheDirectory) ? FPaths::Combine(FPaths::ProjectSavedDir(), Settings->CacheDirectory) : Settings->CacheDirectory;
+	IFileManager::Get().MakeDirectory(*CacheDirectory, true);
+
+	const FString CachePath(IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*CacheDirectory));
+	for (const TCHAR* DeviceName : { TEXT("CPU"), TEXT("GPU"), TEXT("NPU") })
+	{
+		if (SupportsDevice(*OVCore, DeviceName) && ov_core_set_property(OVCore, TCHAR_TO_ANSI(DeviceName), ov_property_key_cache_dir, TCHAR_TO_UTF8(*CachePath)))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to set the OpenVINO cache directory for [%s]."), DeviceName);
+		}
+	}
+
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("OpenVINO model cache: %s"), *CachePath);
+}
+
+void FNNERuntimeOpenVINO::PrecompileAndExit()
+{
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	if (!CacheDirectory.IsEmpty())
+	{
+		const int32 NumCompiled = WarmModelCache(LoadModelAssets());
+		UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Precompiled %d model(s) into %s."), NumCompiled, *CacheDirectory);
+	}
+	else
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The OpenVINO model cache is disabled, enable bEnableModelCache to precompile models."));
+	}
+
+	FPlatformMisc::RequestExit(false, TEXT("OpenVINOPrecompile"));
+}
+
+void FNNERuntimeOpenVINO::SetupSharedModels()
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!Settings || !Settings->bShareCompiledModelsAcrossProcesses || Settings->SharedModelDirectory.IsEmpty() || !SupportsDevice(*OVCore, TEXT("CPU")))
+	{
+		return;
+	}
+
+	const FString Directory = FPaths::IsRelative(Settings->SharedModelDirectory) ? FPaths::Combine(FPaths::ProjectSavedDir(), Settings->SharedModelDirectory) : Settings->SharedModelDirectory;
+	const FString CachePath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*FPaths::Combine(Directory, TEXT("Cache")));
+	IFileManager::Get().MakeDirectory(*FPaths::Combine(Directory, TEXT("Models")), true);
+	IFileManager::Get().MakeDirectory(*CachePath, true);
+
+	// OpenVINO has one cache directory per device, so the shared store takes over the CPU cache set up by SetupModelCache.
+	// Warming the model cache then fills the shared store for CPU models.
+	if (!CacheDirectory.IsEmpty())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("CPU models are cached in the shared compiled model store rather than %s."), *CacheDirectory);
+	}
+
+	// Cached compiled models are mapped rather than read, so every process on the host shares their pages.
+	if (ov_core_set_property(OVCore, nullptr, ov_property_key_enable_mmap, "YES")
+		|| ov_core_set_property(OVCore, "CPU", ov_property_key_cache_dir, TCHAR_TO_UTF8(*CachePath)))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to set up the shared compiled model store in %s."), *Directory);
+		return;
+	}
+
+	SharedModelDirectory = Directory;
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Sharing CPU compiled models through %s"), *SharedModelDirectory);
+}
+
+void FNNERuntimeOpenVINO::SetupWeightsMapping()
+{
+	const UNNERuntimeOpenVINOSettings* Settings = GetDefault<UNNERuntimeOpenVINOSettings>();
+	if (!Settings || !Settings->bMemoryMapWeights || Settings->WeightsDirectory.IsEmpty())
+	{
+		return;
+	}
+
+	// Without a device name the property applies to the core, which is what reads models.
+	if (ov_core_set_property(OVCore, nullptr, ov_property_key_enable_mmap, "YES"))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to enable memory mapped model reading, weights will be loaded into memory."));
+		return;
+	}
+
+	WeightsDirectory = FPaths::IsRelative(Settings->WeightsDirectory) ? FPaths::Combine(FPaths::ProjectSavedDir(), Settings->WeightsDirectory) : Settings->WeightsDirectory;
+	IFileManager::Get().MakeDirectory(*WeightsDirectory, true);
+}
+
+// Hashes the file in chunks so validating multi-gigabyte weights never needs a copy of them in memory.
+static bool HashFile(const FString& Filename, FBlake3Hash& OutHash)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	FBlake3 Hasher;
+	TArray64<uint8> Buffer;
+	Buffer.SetNumUninitialized(FMath::Min<int64>(Reader->TotalSize(), 16 << 20));
+	for (int64 Remaining = Reader->TotalSize(); Remaining > 0;)
+	{
+		const int64 ChunkSize = FMath::Min(Remaining, Buffer.Num());
+		Reader->Serialize(Buffer.GetData(), ChunkSize);
+		Hasher.Update(Buffer.GetData(), ChunkSize);
+		Remaining -= ChunkSize;
+	}
+
+	OutHash = Hasher.Finalize();
+	return Reader->Close();
+}
+
+// Writes through a temporary file so a crash or a concurrent process never leaves a partial file behind.
+// A file left by an earlier run is only reused if its content matches, and only checked once per process.
+bool FNNERuntimeOpenVINO::StageFile(const FString& Filename, TConstArrayView64<uint8> Data)
+{
+	{
+		FScopeLock Lock(&StagedFilesLock);
+		if (StagedFiles.Contains(Filename))
+		{
+			return true;
+		}
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FBlake3Hash DataHash = FBlake3::HashBuffer(Data.GetData(), Data.NumBytes());
+	FBlake3Hash FileHash;
+	if (FileManager.FileSize(*Filename) != Data.NumBytes() || !HashFile(Filename, FileHash) || FileHash != DataHash)
+	{
+		const FString TempFilename = Filename + TEXT(".") + FGuid::NewGuid().ToString(EGuidFormats::Digits);
+		{
+			TUniquePtr<FArchive> Writer(FileManager.CreateFileWriter(*TempFilename));
+			if (!Writer)
+			{
+				return false;
+			}
+
+			Writer->Serialize((void*)Data.GetData(), Data.NumBytes());
+			if (!Writer->Close())
+			{
+				FileManager.Delete(*TempFilename);
+				return false;
+			}
+		}
+
+		// Another process may have staged the same content in the meantime and still have it open.
+		if (!FileManager.Move(*Filename, *TempFilename, true, true))
+		{
+			FileManager.Delete(*TempFilename);
+			if (!HashFile(Filename, FileHash) || FileHash != DataHash)
+			{
+				return false;
+			}
+		}
+	}
+
+	FScopeLock Lock(&StagedFilesLock);
+	StagedFiles.Add(Filename);
+	return true;
+}
+
+FBlake3Hash FNNERuntimeOpenVINO::HashModel(const FOpenVINOModelView& ModelView)
+{
+	if (!ModelView.ContentHash.IsZero())
+	{
+		return ModelView.ContentHash;
+	}
+
+	FBlake3 Hasher;
+	Hasher.Update(ModelView.FileData.GetData(), ModelView.FileData.NumBytes());
+	Hasher.Update(ModelView.WeightsData.GetData(), ModelView.WeightsData.NumBytes());
+	for (const FOpenVINOExternalData& ExternalData : ModelView.ExternalData)
+	{
+		Hasher.Update(*ExternalData.Location, ExternalData.Location.Len() * sizeof(TCHAR));
+		Hasher.Update(ExternalData.Data.GetData(), ExternalData.Data.NumBytes());
+	}
+	return Hasher.Finalize();
+}
+
+bool FNNERuntimeOpenVINO::StageModelFiles(const FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, const FString& Directory, FString& OutModelPath, FString& OutWeightsPath)
+{
+	// Each file starts on a page boundary, which is what lets OpenVINO map the weights rather than copy them.
+	// The source is still resident in the model data while it's written, so the mapping only pays off once that's released.
+	// External data is found relative to the model, so models with external data get a directory of their own.
+	const FString BaseName = ModelView.ExternalData.IsEmpty() ? FPaths::Combine(Directory, LexToString(ContentHash)) : FPaths::Combine(Directory, LexToString(ContentHash), TEXT("Model"));
+	const FString ModelFilename = BaseName + (ModelView.bHasWeights ? TEXT(".xml") : TEXT(".onnx"));
+	const FString WeightsFilename = BaseName + TEXT(".bin");
+
+	if (!StageFile(ModelFilename, ModelView.FileData) || (ModelView.bHasWeights && !StageFile(WeightsFilename, ModelView.WeightsData)))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to stage the model in %s."), *Directory);
+		return false;
+	}
+
+	for (const FOpenVINOExternalData& ExternalData : ModelView.ExternalData)
+	{
+		if (!IsValidExternalDataLocation(ExternalData.Location) || !StageFile(FPaths::Combine(FPaths::GetPath(ModelFilename), ExternalData.Location), ExternalData.Data))
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to stage the external data %s in %s."), *ExternalData.Location, *Directory);
+			return false;
+		}
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	OutModelPath = FileManager.ConvertToAbsolutePathForExternalAppForRead(*ModelFilename);
+	OutWeightsPath = ModelView.bHasWeights ? FileManager.ConvertToAbsolutePathForExternalAppForRead(*WeightsFilename) : FString();
+
+	return true;
+}
+
+bool FNNERuntimeOpenVINO::ReadMappedModel(const FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, ov_model_t*& Model)
+{
+	// ONNX external data can only be read from files, so it's staged even when weights mapping is off.
+	// It's then staged for this process only and deleted at shutdown, rather than kept like mapped weights.
+	const bool bTemporary = WeightsDirectory.IsEmpty();
+	const FString Directory = bTemporary ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("OpenVINO"), TEXT("Temp"), LexToString(FPlatformProcess::GetCurrentProcessId())) : WeightsDirectory;
+	if (bTemporary && !bStagedTemporaryModels.exchange(true))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Staging ONNX external data in %s until shutdown, cook with OnnxConverter to avoid the copy."), *Directory);
+	}
+
+	FString ModelPath;
+	FString WeightsPath;
+	if (!StageModelFiles(ModelView, ContentHash, Directory, ModelPath, WeightsPath))
+	{
+		return false;
+	}
+
+	if (ov_core_read_model(OVCore, TCHAR_TO_UTF8(*ModelPath), WeightsPath.IsEmpty() ? nullptr : TCHAR_TO_UTF8(*WeightsPath), &Model))
+	{
+		if (Model)
+		{
+			ov_model_free(Model);
+			Model = nullptr;
+		}
+
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to read the staged model %s, loading it from memory."), *ModelPath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FNNERuntimeOpenVINO::SharesCompiledModels(const FString& DeviceName) const
+{
+	return !SharedModelDirectory.IsEmpty() && DeviceName == TEXT("CPU");
+}
+
+bool FNNERuntimeOpenVINO::CompileSharedModel(const FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing, const FString& DeviceName, ov_compiled_model_t*& CompiledModel)
+{
+	if (!SharesCompiledModels(DeviceName))
+	{
+		return false;
+	}
+
+	FString ModelPath;
+	FString WeightsPath;
+	if (!StageModelFiles(ModelView, ContentHash, FPaths::Combine(SharedModelDirectory, TEXT("Models")), ModelPath, WeightsPath))
+	{
+		return false;
+	}
+
+	// Compiling from the file lets OpenVINO hash it and map the cached compiled model without reading the source at all.
+	if (PrePostProcessing.PreProcessing.IsEmpty() && PrePostProcessing.PostProcessing.IsEmpty())
+	{
+		if (ov_core_compile_model_from_file(OVCore, TCHAR_TO_UTF8(*ModelPath), TCHAR_TO_ANSI(*DeviceName), 0, &CompiledModel))
+		{
+			CompiledModel = nullptr;
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to compile the shared model %s, compiling it privately."), *ModelPath);
+			return false;
+		}
+
+		return true;
+	}
+
+	// Pre and postprocessing edit the model, so it has to be read. The weights are mapped from the staged file, and
+	// OpenVINO finds the cached compiled model by hashing the processed model instead of the file.
+	ov_model_t* Model = nullptr;
+	if (ov_core_read_model(OVCore, TCHAR_TO_UTF8(*ModelPath), WeightsPath.IsEmpty() ? nullptr : TCHAR_TO_UTF8(*WeightsPath), &Model)
+		|| !ApplyPrePostProcessing(Model, PrePostProcessing)
+		|| ov_core_compile_model(OVCore, Model, TCHAR_TO_ANSI(*DeviceName), 0, &CompiledModel))
+	{
+		if (Model)
+		{
+			ov_model_free(Model);
+		}
+
+		CompiledModel = nullptr;
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to compile the shared model %s with its pre and postprocessing, compiling it privately."), *ModelPath);
+		return false;
+	}
+
+	ov_model_free(Model);
+	return true;
+}
+
+TArray<TObjectPtr<UNNEModelData>> FNNERuntimeOpenVINO::LoadModelAssets()
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.SearchAllAssets(true);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByClass(UNNEModelData::StaticClass()->GetClassPathName(), Assets);
+
+	TArray<TObjectPtr<UNNEModelData>> Models;
+	for (const FAssetData& Asset : Assets)
+	{
+		UNNEModelData* ModelData = Cast<UNNEModelData>(Asset.GetAsset());
+		if (!ModelData)
+		{
+			continue;
+		}
+
+		// An empty target list means the model was cooked for every runtime.
+		TArrayView<const FString> TargetRuntimes = ModelData->GetTargetRuntimes();
+		const bool bUsesOpenVINO = TargetRuntimes.IsEmpty() || TargetRuntimes.ContainsByPredicate([](const FString& RuntimeName)
+		{
+			return RuntimeName.StartsWith(TEXT("NNERuntimeOpenVINO"));
+		});
+
+		if (bUsesOpenVINO)
+		{
+			Models.Add(ModelData);
+		}
+	}
+
+	return Models;
+}
+
+int32 FNNERuntimeOpenVINO::WarmModelCache(TConstArrayView<TObjectPtr<UNNEModelData>> Models, FNNERuntimeOpenVINOPreloader* Preloader)
+{
+	if (CacheDirectory.IsEmpty())
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("The OpenVINO model cache is disabled, enable bEnableModelCache to warm it."));
+		return 0;
+	}
+
+	int32 NumModels = 0;
+	for (ENNERuntimeOpenVINODevice Device : { ENNERuntimeOpenVINODevice::Cpu, ENNERuntimeOpenVINODevice::Gpu, ENNERuntimeOpenVINODevice::Npu })
+	{
+		// The editor registers base runtimes for missing devices so models can still be cooked for them, skip those.
+		const TCHAR* DeviceName = Device == ENNERuntimeOpenVINODevice::Gpu ? TEXT("GPU") : Device == ENNERuntimeOpenVINODevice::Npu ? TEXT("NPU") : TEXT("CPU");
+		if (!SupportsDevice(*OVCore, DeviceName))
+		{
+			continue;
+		}
+
+		const FString RuntimeName(FNNERuntimeOpenVINOPreloader::GetRuntimeName(Device));
+		TWeakInterfacePtr<INNERuntime> Runtime = UE::NNE::GetRuntime<INNERuntime>(RuntimeName);
+		if (!Runtime.IsValid())
+		{
+			continue;
+		}
+
+		if (Preloader)
+		{
+			Preloader->Preload(Models, Device, EQueuedWorkPriority::Low);
+			NumModels += Models.Num();
+			continue;
+		}
+
+		// Instances are only created for their side effect of populating the cache.
+		for (const TObjectPtr<UNNEModelData>& ModelData : Models)
+		{
+			bool bCanCreate = false;
+			bool bCompiled = false;
+			switch (Device)
+			{
+			case ENNERuntimeOpenVINODevice::Cpu:
+			{
+				TWeakInterfacePtr<INNERuntimeCPU> RuntimeCPU = UE::NNE::GetRuntime<INNERuntimeCPU>(RuntimeName);
+				bCanCreate = RuntimeCPU.IsValid() && RuntimeCPU->CanCreateModelCPU(ModelData) == INNERuntimeCPU::ECanCreateModelCPUStatus::Ok;
+				TSharedPtr<UE::NNE::IModelCPU> Model = bCanCreate ? RuntimeCPU->CreateModelCPU(ModelData) : TSharedPtr<UE::NNE::IModelCPU>();
+				bCompiled = Model.IsValid() && Model->CreateModelInstanceCPU().IsValid();
+				break;
+			}
+			case ENNERuntimeOpenVINODevice::Gpu:
+			{
+				TWeakInterfacePtr<INNERuntimeGPU> RuntimeGPU = UE::NNE::GetRuntime<INNERuntimeGPU>(RuntimeName);
+				bCanCreate = RuntimeGPU.IsValid() && RuntimeGPU->CanCreateModelGPU(ModelData) == INNERuntimeGPU::ECanCreateModelGPUStatus::Ok;
+				TSharedPtr<UE::NNE::IModelGPU> Model = bCanCreate ? RuntimeGPU->CreateModelGPU(ModelData) : TSharedPtr<UE::NNE::IModelGPU>();
+				bCompiled = Model.IsValid() && Model->CreateModelInstanceGPU().IsValid();
+				break;
+			}
+			case ENNERuntimeOpenVINODevice::Npu:
+			{
+				TWeakInterfacePtr<INNERuntimeNPU> RuntimeNPU = UE::NNE::GetRuntime<INNERuntimeNPU>(RuntimeName);
+				bCanCreate = RuntimeNPU.IsValid() && RuntimeNPU->CanCreateModelNPU(ModelData) == INNERuntimeNPU::ECanCreateModelNPUStatus::Ok;
+				TSharedPtr<UE::NNE::IModelNPU> Model = bCanCreate ? RuntimeNPU->CreateModelNPU(ModelData) : TSharedPtr<UE::NNE::IModelNPU>();
+				bCompiled = Model.IsValid() && Model->CreateModelInstanceNPU().IsValid();
+				break;
+			}
+			}
+
+			if (bCompiled)
+			{
+				NumModels++;
+			}
+			else if (!bCanCreate)
+			{
+				// Models not cooked for this runtime.
+				UE_LOG(LogNNERuntimeOpenVINO, Verbose, TEXT("Skipping %s, it can't be used with %s."), *ModelData->GetName(), *RuntimeName);
+			}
+			else
+			{
+				UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Failed to precompile %s with %s."), *ModelData->GetName(), *RuntimeName);
+			}
+		}
+	}
+
+	return NumModels;
+}
+
+TSharedPtr<FOpenVINOSharedModel> FNNERuntimeOpenVINO::FindOrReadModel(TSharedRef<UE::NNE::FSharedModelData> ModelData, FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing)
+{
+	// Models with pre and postprocessing are registered apart from the plain one they're read from.
+	const FBlake3Hash ModelKey = GetProcessedModelKey(ContentHash, HashPrePostProcessing(PrePostProcessing));
+
+	TSharedPtr<FModelRegistryEntry> Entry;
+	{
+		FScopeLock Lock(&ModelRegistryLock);
+
+		TSharedPtr<FModelRegistryEntry>& FoundEntry = ModelRegistry.FindOrAdd(ModelKey);
+		if (!FoundEntry)
+		{
+			FoundEntry = MakeShared<FModelRegistryEntry>();
+		}
+		Entry = FoundEntry;
+		++Entry->NumUsers;
+	}
+
+	// A failed read leaves an entry without a model, which is removed like a released one.
+	ON_SCOPE_EXIT
+	{
+		{
+			FScopeLock Lock(&ModelRegistryLock);
+			--Entry->NumUsers;
+		}
+		ReleaseRegistryEntry(ModelKey);
+	};
+
+	// Reading is done under the entry's lock so concurrent requests for the same model wait for one read
+	// rather than each parsing it, without blocking reads of other models.
+	TSharedPtr<FOpenVINOSharedModel> SharedModel;
+	{
+		FScopeLock Lock(&Entry->ReadLock);
+
+		SharedModel = Entry->Model.Pin();
+		if (SharedModel)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Verbose, TEXT("Reusing model %s."), *LexToString(ModelKey));
+			return SharedModel;
+		}
+
+		// Only a model that has to be read is decompressed.
+		if (!DecompressModelData(ModelView))
+		{
+			return {};
+		}
+
+		// Mapped weights are backed by the staged file, the model doesn't need to keep the model data alive.
+		ov_model_t* Model = nullptr;
+		const bool bMapWeights = (!WeightsDirectory.IsEmpty() && ModelView.bHasWeights) || !ModelView.ExternalData.IsEmpty();
+		const bool bMapped = bMapWeights && ReadMappedModel(ModelView, ContentHash, Model);
+		if (!bMapped && !ReadModel(*OVCore, ModelView, Model, &ContentHash))
+		{
+			return {};
+		}
+
+		// The model was just read, no one else uses it yet.
+		if (!ApplyPrePostProcessing(Model, PrePostProcessing))
+		{
+			ov_model_free(Model);
+			return {};
+		}
+
+		if (bMapped)
+		{
+			SharedModel = MakeShareable(new FOpenVINOSharedModel(nullptr, FOpenVINOModelView(), Model), FSharedModelDeleter{ ModelKey });
+		}
+		else
+		{
+			SharedModel = MakeShareable(new FOpenVINOSharedModel(ModelData, ModelView, Model), FSharedModelDeleter{ ModelKey });
+		}
+
+		Entry->Model = SharedModel;
+	}
+
+	return SharedModel;
+}
+
+void FNNERuntimeOpenVINO::FSharedModelDeleter::operator()(FOpenVINOSharedModel* SharedModel) const
+{
+	delete SharedModel;
+
+	// The module may already be shut down when the last instance goes away.
+	if (FNNERuntimeOpenVINO* OVModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName()))
+	{
+		OVModule->ReleaseRegistryEntry(ModelKey);
+	}
+}
+
+void FNNERuntimeOpenVINO::ReleaseRegistryEntry(const FBlake3Hash& ModelKey)
+{
+	FScopeLock Lock(&ModelRegistryLock);
+
+	// The model may have been read again since it was released, or be read right now, in which case the entry stays.
+	// Model is only written by users of the entry, so it can't change while there are none.
+	const TSharedPtr<FModelRegistryEntry>* Entry = ModelRegistry.Find(ModelKey);
+	if (Entry && (*Entry)->NumUsers == 0 && !(*Entry)->Model.IsValid())
+	{
+		ModelRegistry.Remove(ModelKey);
+	}
+}
+
+void FNNERuntimeOpenVINO::RegisterSharedPayload(const FString& ContentHash, TSharedRef<UE::NNE::FSharedModelData> Payload)
+{
+	FScopeLock Lock(&SharedPayloadLock);
+	SharedPayloads.Add(ContentHash, Payload);
+
+	for (auto It = SharedPayloads.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TSharedPtr<UE::NNE::FSharedModelData> FNNERuntimeOpenVINO::FindSharedPayload(const FString& ContentHash)
+{
+	FScopeLock Lock(&SharedPayloadLock);
+	const TWeakPtr<UE::NNE::FSharedModelData>* Payload = SharedPayloads.Find(ContentHash);
+	return Payload ? Payload->Pin() : nullptr;
+}
@@ -24,11 +24,10 @@
 
 #include "NNERuntimeOpenVINONpu.h"
 
-#include "Memory/SharedBuffer.h"
 #include "NNE.h"
 #include "NNEModelData.h"
 #include "NNERuntimeOpenVINOCommon.h"
-#include "Serialization/MemoryWriter.h"
+#include "NNERuntimeOpenVINOMemoryBudget.h"
 
 THIRD_PARTY_INCLUDES_START
 #include "openvino/c/ov_prepostprocess.h"
@@ -36,20 +35,32 @@ THIRD_PARTY_INCLUDES_START
 THIRD_PARTY_INCLUDES_END
 
 FGuid UNNERuntimeOpenVINONpuBase::GUID = FGuid((int32)'O', (int32)'V', (int32)'_', (int32)'N');
-int32 UNNERuntimeOpenVINONpuBase::Version = 0x00000001;
+int32 UNNERuntimeOpenVINONpuBase::Version = 0x00000003;
 
 FModelInstanceOpenVINONpu::~FModelInstanceOpenVINONpu()
 {
+	if (BudgetHandle)
+	{
+		FNNERuntimeOpenVINOMemoryBudget::Get().Unregister(BudgetHandle);
+	}
+
+	if (InferRequest)
+	{
+		ov_infer_request_free(InferRequest);
+	}
+
 	if (CompiledModel)
 	{
 		ov_compiled_model_free(CompiledModel);
 	}
 }
 
-bool FModelInstanceOpenVINONpu::Init(TSharedRef<UE::NNE::FSharedModelData> ModelData)
+bool FModelInstanceOpenVINONpu::Init(TSharedRef<UE::NNE::FSharedModelData> ModelData, TSharedPtr<FOpenVINOModelDataSource> InModelDataSource, const FNNERuntimeOpenVINOInstanceOptions& InOptions, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest)
 {
-	const FString DeviceName(TEXT("NPU"));
-	if (!InitModelInstance(ModelData, CompiledModel, DeviceName))
+	Options = ResolveInstanceOptions(InOptions, InModelDataSource.Get());
+	DeviceName = TEXT("NPU");
+	FBlake3Hash SharedKey;
+	if (!InitModelInstance(ModelData, CompiledModel, CompiledWeights, InferRequest, SharedKey, DeviceName, Options, AsyncRequest))
 	{
 		return false;
 	}
@@ -63,6 +74,13 @@ bool FModelInstanceOpenVINONpu::Init(TSharedRef<UE::NNE::FSharedModelData> Model
 		CompiledModel = nullptr;
 	}
 
+	if (bResult)
+	{
+		ModelDataSource = InModelDataSource;
+
+		BudgetHandle = RegisterModelInstance(ModelData->GetView(), SharedKey, InputSymbolicTensors, OutputSymbolicTensors, CompiledModelLock, CompiledModel, CompiledWeights, InferRequest);
+	}
+
 	return bResult;
 }
 
@@ -88,7 +106,8 @@ TConstArrayView<UE::NNE::FTensorShape> FModelInstanceOpenVINONpu::GetOutputTenso
 
 UE::NNE::EResultStatus FModelInstanceOpenVINONpu::SetInputTensorShapes(TConstArrayView<UE::NNE::FTensorShape> InInputShapes)
 {
-	if (!CompiledModel)
+	// An evicted instance has no compiled model but keeps its model data to restore from.
+	if (!CompiledModel && !(ModelDataSource && ModelDataSource->IsValid()))
 	{
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Invalid compiled model."));
 		return UE::NNE::EResultStatus::Fail;
@@ -111,31 +130,80 @@ UE::NNE::EResultStatus FModelInstanceOpenVINONpu::SetInputTensorShapes(TConstArr
 	}
 
 	InputTensorShapes = InInputShapes;
+
+	// Output shapes are only known up front when the model's are concrete, which is what output regions take their extents from.
+	OutputTensorShapes.Reset(OutputSymbolicTensors.Num());
+	for (const UE::NNE::FTensorDesc& OutputDesc : OutputSymbolicTensors)
+	{
+		if (!OutputDesc.GetShape().IsConcrete())
+		{
+			OutputTensorShapes.Reset();
+			break;
+		}
+
+		OutputTensorShapes.Add(UE::NNE::FTensorShape::MakeFromSymbolic(OutputDesc.GetShape()));
+	}
+
 	return UE::NNE::EResultStatus::Ok;
 }
 
 UE::NNE::EResultStatus FModelInstanceOpenVINONpu::RunSync(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors)
 {
-	return ModelInfer(InInputTensors, InOutputTensors, CompiledModel);
+	return RunModelInstance(InInputTensors, InOutputTensors, ModelDataSource, CompiledModelLock, CompiledModel, CompiledWeights, InferRequest, DeviceName, Options, BudgetHandle);
+}
+
+UE::NNE::EResultStatus FModelInstanceOpenVINONpu::RunSyncOnRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors)
+{
+	FScopeLock ScopeLock(&RegionScratchLock);
+
+	return RunOnTensorRegions(InInputTensors, InOutputTensors, InputSymbolicTensors, OutputSymbolicTensors, InputTensorShapes, OutputTensorShapes, RegionScratch,
+		[this](TConstArrayView<UE::NNE::FTensorBindingCPU> Inputs, TConstArrayView<UE::NNE::FTensorBindingCPU> Outputs)
+		{
+			return RunSync(Inputs, Outputs);
+		});
 }
 
-FModelOpenVINONpu::FModelOpenVINONpu(TSharedRef<UE::NNE::FSharedModelData> InModelData)
-	: ModelData(InModelData)
+FModelOpenVINONpu::FModelOpenVINONpu(TSharedRef<FOpenVINOModelDataSource> InModelDataSource)
+	: ModelDataSource(InModelDataSource)
 {
 }
 
 TSharedPtr<UE::NNE::IModelInstanceNPU> FModelOpenVINONpu::CreateModelInstanceNPU()
 {
+	return CreateModelInstanceNPU(FNNERuntimeOpenVINOInstanceOptions());
+}
+
+TSharedPtr<UE::NNE::IModelInstanceNPU> FModelOpenVINONpu::CreateModelInstanceNPU(const FNNERuntimeOpenVINOInstanceOptions& InOptions)
+{
+	TSharedPtr<UE::NNE::FSharedModelData> ModelData = ModelDataSource->Get();
+
 	TSharedPtr<FModelInstanceOpenVINONpu> ModelInstance = MakeShared<FModelInstanceOpenVINONpu>();
-	if (!ModelInstance->Init(ModelData))
+	if (!ModelData || !ModelInstance->Init(ModelData.ToSharedRef(), ModelDataSource, InOptions))
 	{
 		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Failed to initialize the model instance."));
 		return {};
 	}
 
+	ModelDataSource->ReleaseAfterCompile(TEXT("NPU"));
+
 	return ModelInstance;
 }
 
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> FModelOpenVINONpu::CreateModelInstanceNPUAsync(FOnModelInstanceOpenVINONpuCreated OnCreated, const UObject* Owner)
+{
+	return CreateModelInstanceNPUAsync(FNNERuntimeOpenVINOInstanceOptions(), MoveTemp(OnCreated), Owner);
+}
+
+TSharedRef<FNNERuntimeOpenVINOAsyncRequest> FModelOpenVINONpu::CreateModelInstanceNPUAsync(const FNNERuntimeOpenVINOInstanceOptions& InOptions, FOnModelInstanceOpenVINONpuCreated OnCreated, const UObject* Owner)
+{
+	TSharedRef<FNNERuntimeOpenVINOAsyncRequest> Request = CreateModelInstanceAsync<FModelInstanceOpenVINONpu, UE::NNE::IModelInstanceNPU>(ModelDataSource, InOptions, MoveTemp(OnCreated), Owner);
+
+	// The task holds its own reference to the model data until it has compiled.
+	ModelDataSource->ReleaseAfterCompile(TEXT("NPU"));
+
+	return Request;
+}
+
 FString UNNERuntimeOpenVINONpuBase::GetRuntimeName() const
 {
 	return TEXT("NNERuntimeOpenVINONpu");
@@ -154,22 +222,12 @@ TSharedPtr<UE::NNE::FSharedModelData> UNNERuntimeOpenVINONpuBase::CreateModelDat
 		return {};
 	}
 
-	bool bHasWeights = FileType.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0;
-
-	TArray64<uint8> WrappedFileData;
-	FMemoryWriter64 MemoryWriter(WrappedFileData);
-	MemoryWriter << bHasWeights;
-	MemoryWriter.Serialize((void*)FileData.GetData(), FileData.NumBytes());
-
-	FSharedBuffer SharedBuffer(FSharedBuffer::Clone(WrappedFileData.GetData(), WrappedFileData.NumBytes()));
-
-	TSharedPtr<UE::NNE::FSharedModelData> SharedData(MakeShared<UE::NNE::FSharedModelData>(SharedBuffer, 0));
-	return SharedData;
+	return CreateOpenVINOModelData(FileType, FileData, AdditionalFileData, FileId, TEXT("NPU"), TargetPlatform);
 }
 
 FString UNNERuntimeOpenVINONpuBase::GetModelDataIdentifier(const FString& FileType, TConstArrayView64<uint8> FileData, const TMap<FString, TConstArrayView64<uint8>>& AdditionalFileData, const FGuid& FileId, const ITargetPlatform* TargetPlatform) const
 {
-	return FileId.ToString(EGuidFormats::Digits) + "-" + UNNERuntimeOpenVINONpu::GUID.ToString(EGuidFormats::Digits) + "-" + FString::FromInt(UNNERuntimeOpenVINONpu::Version);
+	return FileId.ToString(EGuidFormats::Digits) + "-" + UNNERuntimeOpenVINONpu::GUID.ToString(EGuidFormats::Digits) + "-" + FString::FromInt(UNNERuntimeOpenVINONpu::Version) + GetModelDataIdentifierSuffix(FileType, FileId, TEXT("NPU"), TargetPlatform);
 }
 
 INNERuntimeNPU::ECanCreateModelNPUStatus UNNERuntimeOpenVINONpu::CanCreateModelNPU(const TObjectPtr<UNNEModelData> ModelData) const
@@ -204,5 +262,5 @@ TSharedPtr<UE::NNE::IModelNPU> UNNERuntimeOpenVINONpu::CreateModelNPU(const TObj
 	}
 
 	TSharedRef<UE::NNE::FSharedModelData> SharedData = ModelData->GetModelData(GetRuntimeName()).ToSharedRef();
-	return MakeShared<FModelOpenVINONpu>(SharedData);
+	return MakeShared<FModelOpenVINONpu>(MakeShared<FOpenVINOModelDataSource>(SharedData, ModelData, GetRuntimeName()));
 }
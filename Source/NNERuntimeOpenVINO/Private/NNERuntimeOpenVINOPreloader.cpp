@@ -0,0 +1,300 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "NNERuntimeOpenVINOPreloader.h"
+
+#include "Misc/QueuedThreadPool.h"
+#include "NNE.h"
+#include "NNEModelData.h"
+#include "NNERuntimeOpenVINOModule.h"
+
+static TSharedPtr<UE::NNE::IModelCPU> CreateModel(INNERuntimeCPU& Runtime, UNNEModelData* ModelData)
+{
+	return Runtime.CanCreateModelCPU(ModelData) == INNERuntimeCPU::ECanCreateModelCPUStatus::Ok ? Runtime.CreateModelCPU(ModelData) : TSharedPtr<UE::NNE::IModelCPU>();
+}
+
+static TSharedPtr<UE::NNE::IModelGPU> CreateModel(INNERuntimeGPU& Runtime, UNNEModelData* ModelData)
+{
+	return Runtime.CanCreateModelGPU(ModelData) == INNERuntimeGPU::ECanCreateModelGPUStatus::Ok ? Runtime.CreateModelGPU(ModelData) : TSharedPtr<UE::NNE::IModelGPU>();
+}
+
+static TSharedPtr<UE::NNE::IModelNPU> CreateModel(INNERuntimeNPU& Runtime, UNNEModelData* ModelData)
+{
+	return Runtime.CanCreateModelNPU(ModelData) == INNERuntimeNPU::ECanCreateModelNPUStatus::Ok ? Runtime.CreateModelNPU(ModelData) : TSharedPtr<UE::NNE::IModelNPU>();
+}
+
+static TSharedPtr<UE::NNE::IModelInstanceCPU> CreateInstance(UE::NNE::IModelCPU& Model)
+{
+	return Model.CreateModelInstanceCPU();
+}
+
+static TSharedPtr<UE::NNE::IModelInstanceGPU> CreateInstance(UE::NNE::IModelGPU& Model)
+{
+	return Model.CreateModelInstanceGPU();
+}
+
+static TSharedPtr<UE::NNE::IModelInstanceNPU> CreateInstance(UE::NNE::IModelNPU& Model)
+{
+	return Model.CreateModelInstanceNPU();
+}
+
+template<typename RuntimeType, typename ModelType>
+static TSharedPtr<ModelType> CreateModel(const FString& RuntimeName, UNNEModelData* ModelData)
+{
+	TWeakInterfacePtr<RuntimeType> Runtime = UE::NNE::GetRuntime<RuntimeType>(RuntimeName);
+	if (!Runtime.IsValid() || !ModelData)
+	{
+		return {};
+	}
+
+	return CreateModel(*Runtime.Get(), ModelData);
+}
+
+FNNERuntimeOpenVINOPreloader::FNNERuntimeOpenVINOPreloader(int32 MaxConcurrentCompiles)
+{
+	// OpenVINO already parallelizes each compile internally, so keep the number of concurrent compiles small.
+	ThreadPool = FQueuedThreadPool::Allocate();
+	verify(ThreadPool->Create(FMath::Max(1, MaxConcurrentCompiles), 128 * 1024, TPri_BelowNormal, TEXT("OpenVINOPreloadPool")));
+}
+
+FNNERuntimeOpenVINOPreloader::~FNNERuntimeOpenVINOPreloader()
+{
+	Reset();
+
+	// Waits for compiles in flight and abandons the rest.
+	ThreadPool->Destroy();
+	delete ThreadPool;
+	ThreadPool = nullptr;
+}
+
+void FNNERuntimeOpenVINOPreloader::Preload(TConstArrayView<TObjectPtr<UNNEModelData>> Models, ENNERuntimeOpenVINODevice Device, EQueuedWorkPriority Priority)
+{
+	check(IsInGameThread());
+
+	const FString RuntimeName(GetRuntimeName(Device));
+
+	for (const TObjectPtr<UNNEModelData>& ModelData : Models)
+	{
+		if (!ModelData)
+		{
+			continue;
+		}
+
+		const FEntryKey Key(ModelData.Get(), Device);
+		if (Entries.Contains(Key))
+		{
+			continue;
+		}
+
+		// Creating the model accesses the asset, so it's done here and only the instance is compiled in the background.
+		TSharedRef<FEntry> Entry = MakeShared<FEntry>();
+		switch (Device)
+		{
+		case ENNERuntimeOpenVINODevice::Cpu:
+			Entry->ModelCPU = CreateModel<INNERuntimeCPU, UE::NNE::IModelCPU>(RuntimeName, ModelData);
+			break;
+		case ENNERuntimeOpenVINODevice::Gpu:
+			Entry->ModelGPU = CreateModel<INNERuntimeGPU, UE::NNE::IModelGPU>(RuntimeName, ModelData);
+			break;
+		case ENNERuntimeOpenVINODevice::Npu:
+			Entry->ModelNPU = CreateModel<INNERuntimeNPU, UE::NNE::IModelNPU>(RuntimeName, ModelData);
+			break;
+		}
+
+		Entries.Add(Key, Entry);
+
+		if (!Entry->ModelCPU && !Entry->ModelGPU && !Entry->ModelNPU)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Warning, TEXT("Can't preload model %s with %s."), *ModelData->GetName(), *RuntimeName);
+			Entry->bDone = true;
+			Entry->DoneEvent->Trigger();
+			continue;
+		}
+
+		Entry->Work = new FPreloadWork(Entry);
+		ThreadPool->AddQueuedWork(Entry->Work, Priority);
+	}
+}
+
+bool FNNERuntimeOpenVINOPreloader::IsReady(const UNNEModelData* ModelData, ENNERuntimeOpenVINODevice Device) const
+{
+	TSharedPtr<FEntry> Entry = FindEntry(ModelData, Device);
+	return Entry.IsValid() && Entry->bDone && (Entry->InstanceCPU || Entry->InstanceGPU || Entry->InstanceNPU);
+}
+
+bool FNNERuntimeOpenVINOPreloader::IsComplete() const
+{
+	for (const TPair<FEntryKey, TSharedRef<FEntry>>& Pair : Entries)
+	{
+		if (!Pair.Value->bDone)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+float FNNERuntimeOpenVINOPreloader::GetProgress() const
+{
+	if (Entries.IsEmpty())
+	{
+		return 1.0f;
+	}
+
+	int32 NumDone = 0;
+	for (const TPair<FEntryKey, TSharedRef<FEntry>>& Pair : Entries)
+	{
+		NumDone += Pair.Value->bDone ? 1 : 0;
+	}
+
+	return (float)NumDone / (float)Entries.Num();
+}
+
+template<typename RuntimeType, typename ModelType, typename InstanceType>
+TSharedPtr<InstanceType> FNNERuntimeOpenVINOPreloader::AcquireInstance(UNNEModelData* ModelData, ENNERuntimeOpenVINODevice Device, TSharedPtr<ModelType> FEntry::* EntryModel, TSharedPtr<InstanceType> FEntry::* EntryInstance)
+{
+	check(IsInGameThread());
+
+	TSharedPtr<FEntry> Entry = FindEntry(ModelData, Device);
+	if (!Entry.IsValid())
+	{
+		// Not preloaded, create it synchronously.
+		TSharedPtr<ModelType> Model = CreateModel<RuntimeType, ModelType>(GetRuntimeName(Device), ModelData);
+		return Model.IsValid() ? CreateInstance(*Model) : TSharedPtr<InstanceType>();
+	}
+
+	WaitForEntry(*Entry);
+
+	TSharedPtr<InstanceType>& Instance = (*Entry).*EntryInstance;
+	if (Instance.IsValid())
+	{
+		return MoveTemp(Instance);
+	}
+
+	// The preloaded instance was already handed out or failed to compile, create another one from the model.
+	const TSharedPtr<ModelType>& Model = (*Entry).*EntryModel;
+	return Model.IsValid() ? CreateInstance(*Model) : TSharedPtr<InstanceType>();
+}
+
+TSharedPtr<UE::NNE::IModelInstanceCPU> FNNERuntimeOpenVINOPreloader::AcquireInstanceCPU(UNNEModelData* ModelData)
+{
+	return AcquireInstance<INNERuntimeCPU>(ModelData, ENNERuntimeOpenVINODevice::Cpu, &FEntry::ModelCPU, &FEntry::InstanceCPU);
+}
+
+TSharedPtr<UE::NNE::IModelInstanceGPU> FNNERuntimeOpenVINOPreloader::AcquireInstanceGPU(UNNEModelData* ModelData)
+{
+	return AcquireInstance<INNERuntimeGPU>(ModelData, ENNERuntimeOpenVINODevice::Gpu, &FEntry::ModelGPU, &FEntry::InstanceGPU);
+}
+
+TSharedPtr<UE::NNE::IModelInstanceNPU> FNNERuntimeOpenVINOPreloader::AcquireInstanceNPU(UNNEModelData* ModelData)
+{
+	return AcquireInstance<INNERuntimeNPU>(ModelData, ENNERuntimeOpenVINODevice::Npu, &FEntry::ModelNPU, &FEntry::InstanceNPU);
+}
+
+void FNNERuntimeOpenVINOPreloader::WaitForEntry(FEntry& Entry)
+{
+	if (!Entry.bDone)
+	{
+		// The work deletes itself once the entry is done, and only the game thread queues new work,
+		// so a work pointer still in the queue can't have been reused.
+		if (Entry.Work && ThreadPool->RetractQueuedWork(Entry.Work))
+		{
+			Entry.Work->DoThreadedWork();
+		}
+		else
+		{
+			Entry.DoneEvent->Wait();
+		}
+	}
+
+	Entry.Work = nullptr;
+}
+
+void FNNERuntimeOpenVINOPreloader::Reset()
+{
+	for (const TPair<FEntryKey, TSharedRef<FEntry>>& Pair : Entries)
+	{
+		Pair.Value->bCancelled = true;
+	}
+
+	Entries.Empty();
+}
+
+FString FNNERuntimeOpenVINOPreloader::GetRuntimeName(ENNERuntimeOpenVINODevice Device)
+{
+	switch (Device)
+	{
+	case ENNERuntimeOpenVINODevice::Gpu:
+		return TEXT("NNERuntimeOpenVINOGpu");
+	case ENNERuntimeOpenVINODevice::Npu:
+		return TEXT("NNERuntimeOpenVINONpu");
+	case ENNERuntimeOpenVINODevice::Cpu:
+	default:
+		return TEXT("NNERuntimeOpenVINOCpu");
+	}
+}
+
+TSharedPtr<FNNERuntimeOpenVINOPreloader::FEntry> FNNERuntimeOpenVINOPreloader::FindEntry(const UNNEModelData* ModelData, ENNERuntimeOpenVINODevice Device) const
+{
+	const TSharedRef<FEntry>* Entry = Entries.Find(FEntryKey(ModelData, Device));
+	if (!Entry)
+	{
+		return {};
+	}
+
+	return *Entry;
+}
+
+void FNNERuntimeOpenVINOPreloader::FPreloadWork::DoThreadedWork()
+{
+	if (!Entry->bCancelled)
+	{
+		if (Entry->ModelCPU.IsValid())
+		{
+			Entry->InstanceCPU = CreateInstance(*Entry->ModelCPU);
+		}
+		else if (Entry->ModelGPU.IsValid())
+		{
+			Entry->InstanceGPU = CreateInstance(*Entry->ModelGPU);
+		}
+		else if (Entry->ModelNPU.IsValid())
+		{
+			Entry->InstanceNPU = CreateInstance(*Entry->ModelNPU);
+		}
+	}
+
+	// The instance is published to the game thread through bDone.
+	Entry->bDone = true;
+	Entry->DoneEvent->Trigger();
+	delete this;
+}
+
+void FNNERuntimeOpenVINOPreloader::FPreloadWork::Abandon()
+{
+	Entry->bDone = true;
+	Entry->DoneEvent->Trigger();
+	delete this;
+}
@@ -0,0 +1,625 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+
+#include "NNERuntimeOpenVINOTensorConversion.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+#include "NNERuntimeOpenVINOModule.h"
+
+// Win64 and Linux are x64 only, where SSE2 is always available. SSSE3 shuffles need the SSE4 baseline.
+#define OPENVINO_CONVERSION_SSE (PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY)
+#define OPENVINO_CONVERSION_SSSE3 (OPENVINO_CONVERSION_SSE && PLATFORM_ALWAYS_HAS_SSE4_1)
+
+#if OPENVINO_CONVERSION_SSE
+#include <emmintrin.h>
+#endif
+#if OPENVINO_CONVERSION_SSSE3
+#include <tmmintrin.h>
+#endif
+
+namespace UE::NNERuntimeOpenVINO::TensorConversion
+{
+
+namespace Private
+{
+
+struct FNormalization
+{
+	int32 SrcChannels[4] = { 0, 1, 2, 3 };
+	float Mul[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	float Add[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+static bool MakeNormalization(int32 NumChannels, TConstArrayView<float> Mean, TConstArrayView<float> Scale, bool bSwapRedBlue, FNormalization& OutNormalization)
+{
+	if ((Mean.Num() > 1 && Mean.Num() != NumChannels) || (Scale.Num() > 1 && Scale.Num() != NumChannels))
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("Mean and scale must hold one value or one per channel (%d)."), NumChannels);
+		return false;
+	}
+
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		const float ChannelMean = Mean.IsEmpty() ? 0.0f : Mean[Mean.Num() > 1 ? Channel : 0];
+		const float ChannelScale = Scale.IsEmpty() ? 1.0f : Scale[Scale.Num() > 1 ? Channel : 0];
+		if (ChannelScale == 0.0f)
+		{
+			UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("The scale of channel %d is 0."), Channel);
+			return false;
+		}
+
+		OutNormalization.SrcChannels[Channel] = bSwapRedBlue && Channel < 3 ? 2 - Channel : Channel;
+		OutNormalization.Mul[Channel] = 1.0f / ChannelScale;
+		OutNormalization.Add[Channel] = -ChannelMean / ChannelScale;
+	}
+
+	return true;
+}
+
+static bool CheckNum(int64 SrcNum, int64 DstNum, const TCHAR* Conversion)
+{
+	if (SrcNum != DstNum)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("%s: the source converts to %lld elements but the destination holds %lld."), Conversion, SrcNum, DstNum);
+		return false;
+	}
+
+	return true;
+}
+
+static bool CheckChannels(int64 Num, int32 NumChannels, const TCHAR* Conversion)
+{
+	if (NumChannels <= 0 || Num % NumChannels)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("%s: %lld elements can't be split into %d channels."), Conversion, Num, NumChannels);
+		return false;
+	}
+
+	return true;
+}
+
+static uint16 FloatToBFloat16(float Value)
+{
+	const uint32 Bits = FMath::AsUInt(Value);
+	if ((Bits & 0x7FFFFFFF) > 0x7F800000)
+	{
+		return (uint16)((Bits | 0x00400000) >> 16);
+	}
+
+	return (uint16)((Bits + 0x7FFF + ((Bits >> 16) & 1)) >> 16);
+}
+
+// Scalar references. The vectorized conversions use them for the elements left over by their vector loops, from Begin.
+
+static void RGBA8ToPlanarFloatScalar(const uint8* Src, float* Dst, int64 NumPixels, int32 NumChannels, const FNormalization& Normalization, int64 Begin = 0)
+{
+	for (int64 Pixel = Begin; Pixel < NumPixels; ++Pixel)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Dst[Channel * NumPixels + Pixel] = Src[Pixel * 4 + Normalization.SrcChannels[Channel]] * Normalization.Mul[Channel] + Normalization.Add[Channel];
+		}
+	}
+}
+
+static void InterleavedToPlanarScalar(const float* Src, float* Dst, int64 NumPixels, int32 NumChannels, int64 Begin = 0)
+{
+	for (int64 Pixel = Begin; Pixel < NumPixels; ++Pixel)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Dst[Channel * NumPixels + Pixel] = Src[Pixel * NumChannels + Channel];
+		}
+	}
+}
+
+static void PlanarToInterleavedScalar(const float* Src, float* Dst, int64 NumPixels, int32 NumChannels, int64 Begin = 0)
+{
+	for (int64 Pixel = Begin; Pixel < NumPixels; ++Pixel)
+	{
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Dst[Pixel * NumChannels + Channel] = Src[Channel * NumPixels + Pixel];
+		}
+	}
+}
+
+static void SwizzleChannels8Scalar(const uint8* Src, uint8* Dst, int64 NumPixels, const uint8 (&Order)[4], int64 Begin = 0)
+{
+	for (int64 Pixel = Begin; Pixel < NumPixels; ++Pixel)
+	{
+		const uint8 Channels[4] = { Src[Pixel * 4], Src[Pixel * 4 + 1], Src[Pixel * 4 + 2], Src[Pixel * 4 + 3] };
+		for (int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			Dst[Pixel * 4 + Channel] = Channels[Order[Channel]];
+		}
+	}
+}
+
+static void FloatToHalfScalar(const float* Src, FFloat16* Dst, int64 Num, int64 Begin = 0)
+{
+	for (int64 Index = Begin; Index < Num; ++Index)
+	{
+		Dst[Index] = FFloat16(Src[Index]);
+	}
+}
+
+static void HalfToFloatScalar(const FFloat16* Src, float* Dst, int64 Num, int64 Begin = 0)
+{
+	for (int64 Index = Begin; Index < Num; ++Index)
+	{
+		Dst[Index] = Src[Index].GetFloat();
+	}
+}
+
+static void FloatToBFloat16Scalar(const float* Src, uint16* Dst, int64 Num, int64 Begin = 0)
+{
+	for (int64 Index = Begin; Index < Num; ++Index)
+	{
+		Dst[Index] = FloatToBFloat16(Src[Index]);
+	}
+}
+
+static void BFloat16ToFloatScalar(const uint16* Src, float* Dst, int64 Num, int64 Begin = 0)
+{
+	for (int64 Index = Begin; Index < Num; ++Index)
+	{
+		Dst[Index] = FMath::AsFloat((uint32)Src[Index] << 16);
+	}
+}
+
+// Vectorized conversions, returning how many pixels or elements they converted.
+
+static int64 RGBA8ToPlanarFloatVector(const uint8* Src, float* Dst, int64 NumPixels, int32 NumChannels, const FNormalization& Normalization)
+{
+	int64 Pixel = 0;
+#if OPENVINO_CONVERSION_SSE
+	const __m128i Zero = _mm_setzero_si128();
+	__m128 Mul[4];
+	__m128 Add[4];
+	for (int32 Channel = 0; Channel < 4; ++Channel)
+	{
+		Mul[Channel] = _mm_set1_ps(Normalization.Mul[Channel]);
+		Add[Channel] = _mm_set1_ps(Normalization.Add[Channel]);
+	}
+
+	for (; Pixel + 4 <= NumPixels; Pixel += 4)
+	{
+		// Widen 4 pixels to one float vector each, then transpose so each vector holds one channel of the 4 pixels.
+		const __m128i Bytes = _mm_loadu_si128((const __m128i*)(Src + Pixel * 4));
+		const __m128i Low = _mm_unpacklo_epi8(Bytes, Zero);
+		const __m128i High = _mm_unpackhi_epi8(Bytes, Zero);
+		__m128 Channels[4] =
+		{
+			_mm_cvtepi32_ps(_mm_unpacklo_epi16(Low, Zero)),
+			_mm_cvtepi32_ps(_mm_unpackhi_epi16(Low, Zero)),
+			_mm_cvtepi32_ps(_mm_unpacklo_epi16(High, Zero)),
+			_mm_cvtepi32_ps(_mm_unpackhi_epi16(High, Zero))
+		};
+		_MM_TRANSPOSE4_PS(Channels[0], Channels[1], Channels[2], Channels[3]);
+
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			const __m128 Value = _mm_add_ps(_mm_mul_ps(Channels[Normalization.SrcChannels[Channel]], Mul[Channel]), Add[Channel]);
+			_mm_storeu_ps(Dst + Channel * NumPixels + Pixel, Value);
+		}
+	}
+#endif
+	return Pixel;
+}
+
+static int64 InterleavedToPlanarVector(const float* Src, float* Dst, int64 NumPixels, int32 NumChannels)
+{
+	int64 Pixel = 0;
+#if OPENVINO_CONVERSION_SSE
+	if (NumChannels == 4)
+	{
+		for (; Pixel + 4 <= NumPixels; Pixel += 4)
+		{
+			__m128 Row0 = _mm_loadu_ps(Src + Pixel * 4);
+			__m128 Row1 = _mm_loadu_ps(Src + Pixel * 4 + 4);
+			__m128 Row2 = _mm_loadu_ps(Src + Pixel * 4 + 8);
+			__m128 Row3 = _mm_loadu_ps(Src + Pixel * 4 + 12);
+			_MM_TRANSPOSE4_PS(Row0, Row1, Row2, Row3);
+			_mm_storeu_ps(Dst + Pixel, Row0);
+			_mm_storeu_ps(Dst + NumPixels + Pixel, Row1);
+			_mm_storeu_ps(Dst + 2 * NumPixels + Pixel, Row2);
+			_mm_storeu_ps(Dst + 3 * NumPixels + Pixel, Row3);
+		}
+	}
+#endif
+	return Pixel;
+}
+
+static int64 PlanarToInterleavedVector(const float* Src, float* Dst, int64 NumPixels, int32 NumChannels)
+{
+	int64 Pixel = 0;
+#if OPENVINO_CONVERSION_SSE
+	if (NumChannels == 4)
+	{
+		for (; Pixel + 4 <= NumPixels; Pixel += 4)
+		{
+			__m128 Row0 = _mm_loadu_ps(Src + Pixel);
+			__m128 Row1 = _mm_loadu_ps(Src + NumPixels + Pixel);
+			__m128 Row2 = _mm_loadu_ps(Src + 2 * NumPixels + Pixel);
+			__m128 Row3 = _mm_loadu_ps(Src + 3 * NumPixels + Pixel);
+			_MM_TRANSPOSE4_PS(Row0, Row1, Row2, Row3);
+			_mm_storeu_ps(Dst + Pixel * 4, Row0);
+			_mm_storeu_ps(Dst + Pixel * 4 + 4, Row1);
+			_mm_storeu_ps(Dst + Pixel * 4 + 8, Row2);
+			_mm_storeu_ps(Dst + Pixel * 4 + 12, Row3);
+		}
+	}
+#endif
+	return Pixel;
+}
+
+static int64 SwizzleChannels8Vector(const uint8* Src, uint8* Dst, int64 NumPixels, const uint8 (&Order)[4])
+{
+	int64 Pixel = 0;
+#if OPENVINO_CONVERSION_SSSE3
+	alignas(16) uint8 ShuffleBytes[16];
+	for (int32 Index = 0; Index < 16; ++Index)
+	{
+		ShuffleBytes[Index] = (uint8)((Index & ~3) + Order[Index & 3]);
+	}
+	const __m128i Shuffle = _mm_load_si128((const __m128i*)ShuffleBytes);
+
+	for (; Pixel + 4 <= NumPixels; Pixel += 4)
+	{
+		const __m128i Bytes = _mm_loadu_si128((const __m128i*)(Src + Pixel * 4));
+		_mm_storeu_si128((__m128i*)(Dst + Pixel * 4), _mm_shuffle_epi8(Bytes, Shuffle));
+	}
+#endif
+	return Pixel;
+}
+
+// The engine's wide half conversions use F16C where the platform always has it and SSE otherwise.
+static int64 FloatToHalfVector(const float* Src, FFloat16* Dst, int64 Num)
+{
+	int64 Index = 0;
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		FPlatformMath::WideVectorStoreHalf((uint16*)(Dst + Index), Src + Index);
+	}
+	return Index;
+}
+
+static int64 HalfToFloatVector(const FFloat16* Src, float* Dst, int64 Num)
+{
+	int64 Index = 0;
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		FPlatformMath::WideVectorLoadHalf(Dst + Index, (const uint16*)(Src + Index));
+	}
+	return Index;
+}
+
+static int64 FloatToBFloat16Vector(const float* Src, uint16* Dst, int64 Num)
+{
+	int64 Index = 0;
+#if OPENVINO_CONVERSION_SSE
+	const __m128i One = _mm_set1_epi32(1);
+	const __m128i RoundingBias = _mm_set1_epi32(0x7FFF);
+	const __m128i AbsMask = _mm_set1_epi32(0x7FFFFFFF);
+	const __m128i Infinity = _mm_set1_epi32(0x7F800000);
+	const __m128i QuietBit = _mm_set1_epi32(0x00400000);
+
+	auto Round = [&](__m128i Bits)
+	{
+		const __m128i Rounded = _mm_add_epi32(Bits, _mm_add_epi32(RoundingBias, _mm_and_si128(_mm_srli_epi32(Bits, 16), One)));
+		const __m128i IsNaN = _mm_cmpgt_epi32(_mm_and_si128(Bits, AbsMask), Infinity);
+		const __m128i Result = _mm_or_si128(_mm_and_si128(IsNaN, _mm_or_si128(Bits, QuietBit)), _mm_andnot_si128(IsNaN, Rounded));
+		// The arithmetic shift keeps the upper halves in the int16 range, so the saturating pack leaves them unchanged.
+		return _mm_srai_epi32(Result, 16);
+	};
+
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const __m128i Low = Round(_mm_loadu_si128((const __m128i*)(Src + Index)));
+		const __m128i High = Round(_mm_loadu_si128((const __m128i*)(Src + Index + 4)));
+		_mm_storeu_si128((__m128i*)(Dst + Index), _mm_packs_epi32(Low, High));
+	}
+#endif
+	return Index;
+}
+
+static int64 BFloat16ToFloatVector(const uint16* Src, float* Dst, int64 Num)
+{
+	int64 Index = 0;
+#if OPENVINO_CONVERSION_SSE
+	const __m128i Zero = _mm_setzero_si128();
+	for (; Index + 8 <= Num; Index += 8)
+	{
+		const __m128i Values = _mm_loadu_si128((const __m128i*)(Src + Index));
+		_mm_storeu_si128((__m128i*)(Dst + Index), _mm_unpacklo_epi16(Zero, Values));
+		_mm_storeu_si128((__m128i*)(Dst + Index + 4), _mm_unpackhi_epi16(Zero, Values));
+	}
+#endif
+	return Index;
+}
+
+} // namespace Private
+
+bool RGBA8ToPlanarFloat(TConstArrayView<uint8> Src, TArrayView<float> Dst, int32 NumChannels, TConstArrayView<float> Mean, TConstArrayView<float> Scale, bool bSwapRedBlue)
+{
+	if (NumChannels != 3 && NumChannels != 4)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("RGBA8ToPlanarFloat: %d channels requested, only 3 or 4 are supported."), NumChannels);
+		return false;
+	}
+
+	const int64 NumPixels = Src.Num() / 4;
+	Private::FNormalization Normalization;
+	if (!Private::CheckChannels(Src.Num(), 4, TEXT("RGBA8ToPlanarFloat")) || !Private::CheckNum(NumPixels * NumChannels, Dst.Num(), TEXT("RGBA8ToPlanarFloat"))
+		|| !Private::MakeNormalization(NumChannels, Mean, Scale, bSwapRedBlue, Normalization))
+	{
+		return false;
+	}
+
+	const int64 Begin = Private::RGBA8ToPlanarFloatVector(Src.GetData(), Dst.GetData(), NumPixels, NumChannels, Normalization);
+	Private::RGBA8ToPlanarFloatScalar(Src.GetData(), Dst.GetData(), NumPixels, NumChannels, Normalization, Begin);
+	return true;
+}
+
+bool InterleavedToPlanar(TConstArrayView<float> Src, TArrayView<float> Dst, int32 NumChannels)
+{
+	if (!Private::CheckChannels(Src.Num(), NumChannels, TEXT("InterleavedToPlanar")) || !Private::CheckNum(Src.Num(), Dst.Num(), TEXT("InterleavedToPlanar")))
+	{
+		return false;
+	}
+
+	const int64 NumPixels = Src.Num() / NumChannels;
+	const int64 Begin = Private::InterleavedToPlanarVector(Src.GetData(), Dst.GetData(), NumPixels, NumChannels);
+	Private::InterleavedToPlanarScalar(Src.GetData(), Dst.GetData(), NumPixels, NumChannels, Begin);
+	return true;
+}
+
+bool PlanarToInterleaved(TConstArrayView<float> Src, TArrayView<float> Dst, int32 NumChannels)
+{
+	if (!Private::CheckChannels(Src.Num(), NumChannels, TEXT("PlanarToInterleaved")) || !Private::CheckNum(Src.Num(), Dst.Num(), TEXT("PlanarToInterleaved")))
+	{
+		return false;
+	}
+
+	const int64 NumPixels = Src.Num() / NumChannels;
+	const int64 Begin = Private::PlanarToInterleavedVector(Src.GetData(), Dst.GetData(), NumPixels, NumChannels);
+	Private::PlanarToInterleavedScalar(Src.GetData(), Dst.GetData(), NumPixels, NumChannels, Begin);
+	return true;
+}
+
+bool SwizzleChannels8(TConstArrayView<uint8> Src, TArrayView<uint8> Dst, const uint8 (&Order)[4])
+{
+	if (!Private::CheckChannels(Src.Num(), 4, TEXT("SwizzleChannels8")) || !Private::CheckNum(Src.Num(), Dst.Num(), TEXT("SwizzleChannels8")))
+	{
+		return false;
+	}
+
+	if (Order[0] > 3 || Order[1] > 3 || Order[2] > 3 || Order[3] > 3)
+	{
+		UE_LOG(LogNNERuntimeOpenVINO, Error, TEXT("SwizzleChannels8: channel indices must be below 4."));
+		return false;
+	}
+
+	const int64 NumPixels = Src.Num() / 4;
+	const int64 Begin = Private::SwizzleChannels8Vector(Src.GetData(), Dst.GetData(), NumPixels, Order);
+	Private::SwizzleChannels8Scalar(Src.GetData(), Dst.GetData(), NumPixels, Order, Begin);
+	return true;
+}
+
+bool FloatToHalf(TConstArrayView<float> Src, TArrayView<FFloat16> Dst)
+{
+	if (!Private::CheckNum(Src.Num(), Dst.Num(), TEXT("FloatToHalf")))
+	{
+		return false;
+	}
+
+	const int64 Begin = Private::FloatToHalfVector(Src.GetData(), Dst.GetData(), Src.Num());
+	Private::FloatToHalfScalar(Src.GetData(), Dst.GetData(), Src.Num(), Begin);
+	return true;
+}
+
+bool HalfToFloat(TConstArrayView<FFloat16> Src, TArrayView<float> Dst)
+{
+	if (!Private::CheckNum(Src.Num(), Dst.Num(), TEXT("HalfToFloat")))
+	{
+		return false;
+	}
+
+	const int64 Begin = Private::HalfToFloatVector(Src.GetData(), Dst.GetData(), Src.Num());
+	Private::HalfToFloatScalar(Src.GetData(), Dst.GetData(), Src.Num(), Begin);
+	return true;
+}
+
+bool FloatToBFloat16(TConstArrayView<float> Src, TArrayView<uint16> Dst)
+{
+	if (!Private::CheckNum(Src.Num(), Dst.Num(), TEXT("FloatToBFloat16")))
+	{
+		return false;
+	}
+
+	const int64 Begin = Private::FloatToBFloat16Vector(Src.GetData(), Dst.GetData(), Src.Num());
+	Private::FloatToBFloat16Scalar(Src.GetData(), Dst.GetData(), Src.Num(), Begin);
+	return true;
+}
+
+bool BFloat16ToFloat(TConstArrayView<uint16> Src, TArrayView<float> Dst)
+{
+	if (!Private::CheckNum(Src.Num(), Dst.Num(), TEXT("BFloat16ToFloat")))
+	{
+		return false;
+	}
+
+	const int64 Begin = Private::BFloat16ToFloatVector(Src.GetData(), Dst.GetData(), Src.Num());
+	Private::BFloat16ToFloatScalar(Src.GetData(), Dst.GetData(), Src.Num(), Begin);
+	return true;
+}
+
+namespace Private
+{
+
+// Best of several runs, in milliseconds.
+template<typename FunctionType>
+static double TimeConversion(FunctionType&& Function)
+{
+	constexpr int32 NumRuns = 20;
+
+	double Best = TNumericLimits<double>::Max();
+	for (int32 Run = 0; Run < NumRuns; ++Run)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Function();
+		Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+	}
+
+	return Best * 1000.0;
+}
+
+static void LogBenchmark(const TCHAR* Conversion, double VectorTime, double ScalarTime, int64 NumBytes, bool bMatches)
+{
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("  %-20s %8.3f ms (%6.2f GB/s), scalar %8.3f ms, %5.2fx%s"), Conversion,
+		VectorTime, NumBytes / (VectorTime * 1.0e6), ScalarTime, ScalarTime / FMath::Max(VectorTime, UE_SMALL_NUMBER),
+		bMatches ? TEXT("") : TEXT(", results differ from the scalar reference"));
+}
+
+template<typename ElementType>
+static bool Matches(const TArray<ElementType>& Result, const TArray<ElementType>& Reference)
+{
+	return FMemory::Memcmp(Result.GetData(), Reference.GetData(), Result.Num() * sizeof(ElementType)) == 0;
+}
+
+// Results of the float conversions may differ in the last bit where the compiler contracts the scalar references into FMAs.
+static bool NearlyMatches(TConstArrayView<float> Result, TConstArrayView<float> Reference)
+{
+	for (int32 Index = 0; Index < Result.Num(); ++Index)
+	{
+		if (!FMath::IsNearlyEqual(Result[Index], Reference[Index], FMath::Abs(Reference[Index]) * 1.0e-6f + UE_SMALL_NUMBER)
+			&& !(FMath::IsNaN(Result[Index]) && FMath::IsNaN(Reference[Index])))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void BenchmarkConversions(const TArray<FString>& Args)
+{
+	const int32 NumPixels = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1920 * 1080;
+	const int64 Num = NumPixels * 4ll;
+
+	FRandomStream Random(1234);
+	TArray<uint8> Pixels;
+	TArray<float> Floats;
+	Pixels.SetNumUninitialized(Num);
+	Floats.SetNumUninitialized(Num);
+	for (int64 Index = 0; Index < Num; ++Index)
+	{
+		Pixels[Index] = (uint8)Random.RandRange(0, 255);
+		Floats[Index] = Random.FRandRange(-1000.0f, 1000.0f);
+	}
+
+	TArray<float> FloatResult, FloatReference;
+	TArray<uint8> ByteResult, ByteReference;
+	TArray<FFloat16> HalfResult, HalfReference;
+	TArray<uint16> BFloat16Result, BFloat16Reference;
+	FloatResult.SetNumUninitialized(Num);
+	FloatReference.SetNumUninitialized(Num);
+	ByteResult.SetNumUninitialized(Num);
+	ByteReference.SetNumUninitialized(Num);
+	HalfResult.SetNumUninitialized(Num);
+	HalfReference.SetNumUninitialized(Num);
+	BFloat16Result.SetNumUninitialized(Num);
+	BFloat16Reference.SetNumUninitialized(Num);
+
+	UE_LOG(LogNNERuntimeOpenVINO, Display, TEXT("Benchmarking tensor conversions of %d pixels (%lld elements)%s:"), NumPixels, Num,
+		OPENVINO_CONVERSION_SSE ? TEXT("") : TEXT(", vectorization unavailable on this platform"));
+
+	{
+		const float Mean[3] = { 123.675f, 116.28f, 103.53f };
+		const float Scale[3] = { 58.395f, 57.12f, 57.375f };
+		FNormalization Normalization;
+		MakeNormalization(3, Mean, Scale, true, Normalization);
+		const TArrayView<float> Result = MakeArrayView(FloatResult.GetData(), NumPixels * 3);
+		const double VectorTime = TimeConversion([&]() { RGBA8ToPlanarFloat(Pixels, Result, 3, Mean, Scale, true); });
+		const double ScalarTime = TimeConversion([&]() { RGBA8ToPlanarFloatScalar(Pixels.GetData(), FloatReference.GetData(), NumPixels, 3, Normalization); });
+		LogBenchmark(TEXT("RGBA8ToPlanarFloat"), VectorTime, ScalarTime, Num + NumPixels * 3 * sizeof(float), NearlyMatches(Result, MakeArrayView(FloatReference.GetData(), NumPixels * 3)));
+	}
+
+	{
+		const double VectorTime = TimeConversion([&]() { InterleavedToPlanar(Floats, FloatResult, 4); });
+		const double ScalarTime = TimeConversion([&]() { InterleavedToPlanarScalar(Floats.GetData(), FloatReference.GetData(), NumPixels, 4); });
+		LogBenchmark(TEXT("InterleavedToPlanar"), VectorTime, ScalarTime, Num * 2 * sizeof(float), NearlyMatches(FloatResult, FloatReference));
+	}
+
+	{
+		const double VectorTime = TimeConversion([&]() { PlanarToInterleaved(Floats, FloatResult, 4); });
+		const double ScalarTime = TimeConversion([&]() { PlanarToInterleavedScalar(Floats.GetData(), FloatReference.GetData(), NumPixels, 4); });
+		LogBenchmark(TEXT("PlanarToInterleaved"), VectorTime, ScalarTime, Num * 2 * sizeof(float), NearlyMatches(FloatResult, FloatReference));
+	}
+
+	{
+		const uint8 Order[4] = { 2, 1, 0, 3 };
+		const double VectorTime = TimeConversion([&]() { SwizzleChannels8(Pixels, ByteResult, Order); });
+		const double ScalarTime = TimeConversion([&]() { SwizzleChannels8Scalar(Pixels.GetData(), ByteReference.GetData(), NumPixels, Order); });
+		LogBenchmark(TEXT("SwizzleChannels8"), VectorTime, ScalarTime, Num * 2, Matches(ByteResult, ByteReference));
+	}
+
+	{
+		const double VectorTime = TimeConversion([&]() { FloatToHalf(Floats, HalfResult); });
+		const double ScalarTime = TimeConversion([&]() { FloatToHalfScalar(Floats.GetData(), HalfReference.GetData(), Num); });
+		LogBenchmark(TEXT("FloatToHalf"), VectorTime, ScalarTime, Num * (sizeof(float) + sizeof(FFloat16)), Matches(HalfResult, HalfReference));
+	}
+
+	{
+		const double VectorTime = TimeConversion([&]() { HalfToFloat(HalfReference, FloatResult); });
+		const double ScalarTime = TimeConversion([&]() { HalfToFloatScalar(HalfReference.GetData(), FloatReference.GetData(), Num); });
+		LogBenchmark(TEXT("HalfToFloat"), VectorTime, ScalarTime, Num * (sizeof(float) + sizeof(FFloat16)), NearlyMatches(FloatResult, FloatReference));
+	}
+
+	{
+		const double VectorTime = TimeConversion([&]() { FloatToBFloat16(Floats, BFloat16Result); });
+		const double ScalarTime = TimeConversion([&]() { FloatToBFloat16Scalar(Floats.GetData(), BFloat16Reference.GetData(), Num); });
+		LogBenchmark(TEXT("FloatToBFloat16"), VectorTime, ScalarTime, Num * (sizeof(float) + sizeof(uint16)), Matches(BFloat16Result, BFloat16Reference));
+	}
+
+	{
+		const double VectorTime = TimeConversion([&]() { BFloat16ToFloat(BFloat16Reference, FloatResult); });
+		const double ScalarTime = TimeConversion([&]() { BFloat16ToFloatScalar(BFloat16Reference.GetData(), FloatReference.GetData(), Num); });
+		LogBenchmark(TEXT("BFloat16ToFloat"), VectorTime, ScalarTime, Num * (sizeof(float) + sizeof(uint16)), NearlyMatches(FloatResult, FloatReference));
+	}
+}
+
+static FAutoConsoleCommand BenchmarkConversionsCommand(
+	TEXT("OpenVINO.BenchmarkConversions"),
+	TEXT("Times the tensor conversions against their scalar references and checks they give the same results. Optional argument: number of RGBA pixels, 1920x1080 by default."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkConversions));
+
+} // namespace Private
+
+} // namespace UE::NNERuntimeOpenVINO::TensorConversion
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+#include <atomic>
+
+/**
+ * Tracks a model instance being created on a background thread.
+ * The request is cancelled explicitly with Cancel() or implicitly when its owner is destroyed,
+ * in which case the instance is discarded instead of being handed to the completion delegate.
+ */
+class NNERUNTIMEOPENVINO_API FNNERuntimeOpenVINOAsyncRequest
+{
+public:
+	explicit FNNERuntimeOpenVINOAsyncRequest(const UObject* InOwner = nullptr);
+
+	void Cancel();
+	bool IsCancelled() const;
+
+	/**
+	 * Progress in [0, 1], advanced as the model data is parsed, the model is read, compiled and warmed up.
+	 * Compilation can't be interrupted so cancellation takes effect between stages.
+	 */
+	float GetProgress() const;
+	bool IsDone() const;
+
+private:
+	// Only the instance creation code reports progress.
+	friend struct FOpenVINOAsyncProgress;
+
+	void SetProgress(float InProgress);
+	void MarkDone();
+
+	TWeakObjectPtr<const UObject> Owner;
+	bool bHasOwner = false;
+
+	std::atomic<bool> bCancelled{ false };
+	std::atomic<bool> bDone{ false };
+	std::atomic<float> Progress{ 0.0f };
+};
@@ -36,7 +36,10 @@
 #include "UObject/Object.h"
 #include "UObject/UObjectBaseUtility.h"
 
+#include "NNERuntimeOpenVINOAsync.h"
+#include "NNERuntimeOpenVINOInstanceOptions.h"
 #include "NNERuntimeOpenVINOModule.h"
+#include "NNERuntimeOpenVINOTensorRegion.h"
 
 THIRD_PARTY_INCLUDES_START
 #include "openvino/c/ov_model.h"
@@ -44,13 +47,15 @@ THIRD_PARTY_INCLUDES_END
 
 #include "NNERuntimeOpenVINOCpu.generated.h"
 
+DECLARE_DELEGATE_OneParam(FOnModelInstanceOpenVINOCpuCreated, TSharedPtr<UE::NNE::IModelInstanceCPU>);
+
 class FModelInstanceOpenVINOCpu : public UE::NNE::IModelInstanceCPU
 {
 public:
 	FModelInstanceOpenVINOCpu() = default;
 	virtual ~FModelInstanceOpenVINOCpu();
 
-	bool Init(TSharedRef<UE::NNE::FSharedModelData> ModelData);
+	bool Init(TSharedRef<UE::NNE::FSharedModelData> ModelData, TSharedPtr<FOpenVINOModelDataSource> InModelDataSource, const FNNERuntimeOpenVINOInstanceOptions& InOptions, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest = nullptr);
 
 	virtual TConstArrayView<UE::NNE::FTensorDesc> GetInputTensorDescs() const override;
 	virtual TConstArrayView<UE::NNE::FTensorDesc> GetOutputTensorDescs() const override;
@@ -61,6 +66,9 @@ public:
 
 	virtual UE::NNE::EResultStatus RunSync(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors) override;
 
+	/** Runs on regions of larger buffers, binding contiguous regions in place, see FNNERuntimeOpenVINOTensorRegion. */
+	NNERUNTIMEOPENVINO_API UE::NNE::EResultStatus RunSyncOnRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors);
+
 private:
 	TArray<UE::NNE::FTensorShape> InputTensorShapes;
 	TArray<UE::NNE::FTensorShape> OutputTensorShapes;
@@ -68,18 +76,46 @@ private:
 	TArray<UE::NNE::FTensorDesc> OutputSymbolicTensors;
 
 	ov_compiled_model_t* CompiledModel = nullptr;
+	ov_infer_request_t* InferRequest = nullptr;
+	// Released after the compiled model, which may use these weights in place.
+	TSharedPtr<const FOpenVINOModelWeights> CompiledWeights;
+
+	// Kept so the compiled model can be restored after the memory budget evicts it.
+	TSharedPtr<FOpenVINOModelDataSource> ModelDataSource;
+	FNNERuntimeOpenVINOInstanceOptions Options;
+	FString DeviceName;
+	FCriticalSection CompiledModelLock;
+	uint64 BudgetHandle = 0;
+
+	// Dense copies of the non-contiguous regions the instance runs on, reused while the shapes stay the same.
+	FCriticalSection RegionScratchLock;
+	TArray<TArray64<uint8>> RegionScratch;
+
+	// Set instead of the compiled model when the instance runs in the inference daemon.
+	TSharedPtr<FOpenVINODaemonClient> DaemonClient;
 };
 
 class FModelOpenVINOCpu : public UE::NNE::IModelCPU
 {
 public:
-	FModelOpenVINOCpu(TSharedRef<UE::NNE::FSharedModelData> InModelData);
+	FModelOpenVINOCpu(TSharedRef<FOpenVINOModelDataSource> InModelDataSource);
 	virtual ~FModelOpenVINOCpu() = default;
 
 	virtual TSharedPtr<UE::NNE::IModelInstanceCPU> CreateModelInstanceCPU() override;
 
+	/** Creates an instance compiled with options that change the model, see FNNERuntimeOpenVINOInstanceOptions. */
+	NNERUNTIMEOPENVINO_API TSharedPtr<UE::NNE::IModelInstanceCPU> CreateModelInstanceCPU(const FNNERuntimeOpenVINOInstanceOptions& InOptions);
+
+	/**
+	 * Reads and compiles the model on a background task instead of the calling thread.
+	 * OnCreated is called on the game thread with the new instance, or null on failure, unless the request
+	 * was cancelled or Owner was destroyed in the meantime.
+	 */
+	NNERUNTIMEOPENVINO_API TSharedRef<FNNERuntimeOpenVINOAsyncRequest> CreateModelInstanceCPUAsync(FOnModelInstanceOpenVINOCpuCreated OnCreated, const UObject* Owner = nullptr);
+	NNERUNTIMEOPENVINO_API TSharedRef<FNNERuntimeOpenVINOAsyncRequest> CreateModelInstanceCPUAsync(const FNNERuntimeOpenVINOInstanceOptions& InOptions, FOnModelInstanceOpenVINOCpuCreated OnCreated, const UObject* Owner = nullptr);
+
 private:
-	TSharedRef<UE::NNE::FSharedModelData> ModelData;
+	TSharedRef<FOpenVINOModelDataSource> ModelDataSource;
 };
 
 UCLASS()
@@ -36,7 +36,10 @@
 #include "UObject/Object.h"
 #include "UObject/UObjectBaseUtility.h"
 
+#include "NNERuntimeOpenVINOAsync.h"
+#include "NNERuntimeOpenVINOInstanceOptions.h"
 #include "NNERuntimeOpenVINOModule.h"
+#include "NNERuntimeOpenVINOTensorRegion.h"
 
 THIRD_PARTY_INCLUDES_START
 #include "openvino/c/ov_model.h"
@@ -58,13 +61,15 @@ public:
 private:
 };
 
+DECLARE_DELEGATE_OneParam(FOnModelInstanceOpenVINOGpuCreated, TSharedPtr<UE::NNE::IModelInstanceGPU>);
+
 class FModelInstanceOpenVINOGpu : public UE::NNE::IModelInstanceGPU
 {
 public:
 	FModelInstanceOpenVINOGpu() = default;
 	virtual ~FModelInstanceOpenVINOGpu();
 
-	bool Init(TSharedRef<UE::NNE::FSharedModelData> ModelData);
+	bool Init(TSharedRef<UE::NNE::FSharedModelData> ModelData, TSharedPtr<FOpenVINOModelDataSource> InModelDataSource, const FNNERuntimeOpenVINOInstanceOptions& InOptions, FNNERuntimeOpenVINOAsyncRequest* AsyncRequest = nullptr);
 
 	virtual TConstArrayView<UE::NNE::FTensorDesc> GetInputTensorDescs() const override;
 	virtual TConstArrayView<UE::NNE::FTensorDesc> GetOutputTensorDescs() const override;
@@ -75,6 +80,9 @@ public:
 
 	virtual UE::NNE::EResultStatus RunSync(TConstArrayView<UE::NNE::FTensorBindingCPU> InInputTensors, TConstArrayView<UE::NNE::FTensorBindingCPU> InOutputTensors) override;
 
+	/** Runs on regions of larger buffers, binding contiguous regions in place, see FNNERuntimeOpenVINOTensorRegion. */
+	NNERUNTIMEOPENVINO_API UE::NNE::EResultStatus RunSyncOnRegions(TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InInputTensors, TConstArrayView<FNNERuntimeOpenVINOTensorRegion> InOutputTensors);
+
 private:
 	TArray<UE::NNE::FTensorShape> InputTensorShapes;
 	TArray<UE::NNE::FTensorShape> OutputTensorShapes;
@@ -82,18 +90,43 @@ private:
 	TArray<UE::NNE::FTensorDesc> OutputSymbolicTensors;
 
 	ov_compiled_model_t* CompiledModel = nullptr;
+	ov_infer_request_t* InferRequest = nullptr;
+	// Released after the compiled model, which may use these weights in place.
+	TSharedPtr<const FOpenVINOModelWeights> CompiledWeights;
+
+	// Kept so the compiled model can be restored after the memory budget evicts it.
+	TSharedPtr<FOpenVINOModelDataSource> ModelDataSource;
+	FNNERuntimeOpenVINOInstanceOptions Options;
+	FString DeviceName;
+	FCriticalSection CompiledModelLock;
+	uint64 BudgetHandle = 0;
+
+	// Dense copies of the non-contiguous regions the instance runs on, reused while the shapes stay the same.
+	FCriticalSection RegionScratchLock;
+	TArray<TArray64<uint8>> RegionScratch;
 };
 
 class FModelOpenVINOGpu : public UE::NNE::IModelGPU
 {
 public:
-	FModelOpenVINOGpu(TSharedRef<UE::NNE::FSharedModelData> InModelData);
+	FModelOpenVINOGpu(TSharedRef<FOpenVINOModelDataSource> InModelDataSource);
 	virtual ~FModelOpenVINOGpu() = default;
 
 	virtual TSharedPtr<UE::NNE::IModelInstanceGPU> CreateModelInstanceGPU() override;
 
+	/** Creates an instance compiled with options that change the model, see FNNERuntimeOpenVINOInstanceOptions. */
+	NNERUNTIMEOPENVINO_API TSharedPtr<UE::NNE::IModelInstanceGPU> CreateModelInstanceGPU(const FNNERuntimeOpenVINOInstanceOptions& InOptions);
+
+	/**
+	 * Reads and compiles the model on a background task instead of the calling thread.
+	 * OnCreated is called on the game thread with the new instance, or null on failure, unless the request
+	 * was cancelled or Owner was destroyed in the meantime.
+	 */
+	NNERUNTIMEOPENVINO_API TSharedRef<FNNERuntimeOpenVINOAsyncRequest> CreateModelInstanceGPUAsync(FOnModelInstanceOpenVINOGpuCreated OnCreated, const UObject* Owner = nullptr);
+	NNERUNTIMEOPENVINO_API TSharedRef<FNNERuntimeOpenVINOAsyncRequest> CreateModelInstanceGPUAsync(const FNNERuntimeOpenVINOInstanceOptions& InOptions, FOnModelInstanceOpenVINOGpuCreated OnCreated, const UObject* Owner = nullptr);
+
 private:
-	TSharedRef<UE::NNE::FSharedModelData> ModelData;
+	TSharedRef<FOpenVINOModelDataSource> ModelDataSource;
 };
 
 UCLASS()
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NNETypes.h"
+
+#include "NNERuntimeOpenVINOSettings.h"
+
+/** The value an input keeps for the lifetime of a model instance. */
+struct FNNERuntimeOpenVINOConstantInput
+{
+	/** Name of the input, as in the input tensor descs of the model. */
+	FString Name;
+	UE::NNE::FTensorShape Shape;
+	ENNETensorDataType DataType = ENNETensorDataType::Float;
+	/** Shape.Volume() elements of DataType. */
+	TArray<uint8> Data;
+};
+
+/** Options for creating a model instance that change the model it compiles. */
+struct FNNERuntimeOpenVINOInstanceOptions
+{
+	/**
+	 * Inputs substituted into the model as constants before it's compiled, so OpenVINO folds everything that only
+	 * depends on them. Frozen inputs are no longer inputs of the instance. Only supported by IR models.
+	 */
+	TArray<FNNERuntimeOpenVINOConstantInput> ConstantInputs;
+
+	/**
+	 * Names of the outputs the instance computes, as in the output tensor descs of the model, or all outputs when empty.
+	 * Nodes only other outputs depend on are left out of the compiled model. Outputs keep the order of the model.
+	 */
+	TArray<FString> Outputs;
+
+	/** Preprocessing built into the model, replacing the one configured for the asset in the settings when set. */
+	TArray<FNNERuntimeOpenVINOInputPreProcess> PreProcessing;
+
+	/**
+	 * Output conversions built into the model, replacing the ones configured for the asset in the settings when set.
+	 * Like the preprocessing they're part of the key compiled models are cached and shared by, not a private variant.
+	 */
+	TArray<FNNERuntimeOpenVINOOutputPostProcess> PostProcessing;
+
+	bool IsEmpty() const
+	{
+		return ConstantInputs.IsEmpty() && Outputs.IsEmpty() && PreProcessing.IsEmpty() && PostProcessing.IsEmpty();
+	}
+
+	/**
+	 * Whether the instance compiles a variant of the model no other instance uses, so nothing precompiled, cached or
+	 * shared matches it. Pre and postprocessing don't, models compiled with them are found by their description.
+	 */
+	bool NeedsPrivateModel() const
+	{
+		return !ConstantInputs.IsEmpty() || !Outputs.IsEmpty();
+	}
+};
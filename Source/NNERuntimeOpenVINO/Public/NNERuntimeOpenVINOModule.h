@@ -25,6 +25,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Hash/Blake3.h"
+#include "Misc/ScopeLock.h"
 #include "Modules/ModuleInterface.h"
 #include "UObject/WeakObjectPtr.h"
 
@@ -32,6 +34,8 @@ THIRD_PARTY_INCLUDES_START
 #include "openvino/c/ov_core.h"
 THIRD_PARTY_INCLUDES_END
 
+#include <atomic>
+
 DECLARE_LOG_CATEGORY_EXTERN(LogNNERuntimeOpenVINO, Log, All);
 
 #if WITH_EDITOR
@@ -39,6 +43,15 @@ class UNNERuntimeOpenVINOGpuBase;
 class UNNERuntimeOpenVINONpuBase;
 #endif
 
+class FNNERuntimeOpenVINOPreloader;
+class FOpenVINODaemonClient;
+class FOpenVINOModelDataSource;
+class FOpenVINOSharedModel;
+struct FOpenVINOModelWeights;
+struct FNNERuntimeOpenVINOInstanceOptions;
+struct FOpenVINOModelView;
+namespace UE::NNE { class FSharedModelData; }
+class UNNEModelData;
 class UNNERuntimeOpenVINOCpu;
 class UNNERuntimeOpenVINONpu;
 class UNNERuntimeOpenVINOGpu;
@@ -51,7 +64,59 @@ public:
 
 	ov_core_t& OpenVINOInstance() { return *OVCore; };
 
-	static FName ModuleName();
+	NNERUNTIMEOPENVINO_API static FName ModuleName();
+
+	/** Directory OpenVINO caches compiled models in, empty if caching is disabled. */
+	const FString& GetCacheDirectory() const { return CacheDirectory; }
+
+	/** Loads every model data asset that can be used with the OpenVINO runtimes. */
+	NNERUNTIMEOPENVINO_API static TArray<TObjectPtr<UNNEModelData>> LoadModelAssets();
+
+	/**
+	 * Compiles the models for every OpenVINO device available on this machine to fill the OpenVINO cache,
+	 * so the first use of each model is a cache hit. Meant for install time, see -OpenVINOPrecompile, or a loading screen.
+	 * When a preloader is given the models are queued on it instead and this returns immediately.
+	 * Returns the number of models compiled or queued.
+	 */
+	NNERUNTIMEOPENVINO_API int32 WarmModelCache(TConstArrayView<TObjectPtr<UNNEModelData>> Models, FNNERuntimeOpenVINOPreloader* Preloader = nullptr);
+
+	/**
+	 * Returns the OpenVINO model read from the given model data. Model data with identical content, e.g. the same
+	 * network used by several runtimes or duplicated assets, shares one model for as long as anyone holds it.
+	 * ContentHash is the model's HashModel. The view is decompressed only if the model has to be read.
+	 * The pre and postprocessing of the options are built into the model, it's only shared with the same ones.
+	 */
+	TSharedPtr<FOpenVINOSharedModel> FindOrReadModel(TSharedRef<UE::NNE::FSharedModelData> ModelData, FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing);
+
+	/** Whether IR weights are read from staged files OpenVINO maps rather than from memory, see bMemoryMapWeights. */
+	bool MapsWeights() const { return !WeightsDirectory.IsEmpty(); }
+
+	/** Whether models compiled for the device go through the store shared by every process on the host. */
+	bool SharesCompiledModels(const FString& DeviceName) const;
+
+	/**
+	 * Compiles the model through the store shared by every process on the host, see SharesCompiledModels.
+	 * Once one process has compiled a model, the others map the cached result and share its pages.
+	 * ContentHash is the model's HashModel, which also identifies the mapped result instances of the same model share.
+	 * The pre and postprocessing of the options are built into the model, OpenVINO then caches it under its own hash.
+	 */
+	bool CompileSharedModel(const FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, const FNNERuntimeOpenVINOInstanceOptions& PrePostProcessing, const FString& DeviceName, ov_compiled_model_t*& CompiledModel);
+
+	/** Hash identifying a model by its content. Uses the hash stored at cook if there is one, otherwise the view must be decompressed. */
+	static FBlake3Hash HashModel(const FOpenVINOModelView& ModelView);
+
+	/** Makes model data other runtimes refer to by content hash findable while anyone holds it. */
+	void RegisterSharedPayload(const FString& ContentHash, TSharedRef<UE::NNE::FSharedModelData> Payload);
+	TSharedPtr<UE::NNE::FSharedModelData> FindSharedPayload(const FString& ContentHash);
+
+	/** Writes the model to standalone files named by content hash in Directory, unless they're already there. */
+	bool StageModelFiles(const FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, const FString& Directory, FString& OutModelPath, FString& OutWeightsPath);
+
+	/**
+	 * Reads the model from staged files. Staging writes a copy of the model, weights and external data to disk once per content hash,
+	 * OpenVINO then maps that copy rather than copying the data into its own memory again.
+	 */
+	bool ReadMappedModel(const FOpenVINOModelView& ModelView, const FBlake3Hash& ContentHash, ov_model_t*& Model);
 
 private:
 #if WITH_EDITOR
@@ -67,8 +132,47 @@ private:
 	ov_core_t* OVCore = nullptr;
 	void* OpenVINODLL = nullptr;
 
+	FString CacheDirectory;
+	FString WeightsDirectory;
+	std::atomic<bool> bStagedTemporaryModels{ false };
+	FString SharedModelDirectory;
+
+	struct FModelRegistryEntry
+	{
+		FCriticalSection ReadLock;
+		TWeakPtr<FOpenVINOSharedModel> Model;
+		// Threads that looked the entry up and may still read into it, only changed under ModelRegistryLock.
+		// Model is only written while this is above zero.
+		int32 NumUsers = 0;
+	};
+
+	FCriticalSection ModelRegistryLock;
+	TMap<FBlake3Hash, TSharedPtr<FModelRegistryEntry>> ModelRegistry;
+
+	// Removes a model's registry entry once its last user releases it and no one is reading into it.
+	struct FSharedModelDeleter
+	{
+		FBlake3Hash ModelKey;
+		void operator()(FOpenVINOSharedModel* SharedModel) const;
+	};
+
+	void ReleaseRegistryEntry(const FBlake3Hash& ModelKey);
+
+	// Files StageFile has written or checked against their content since startup.
+	FCriticalSection StagedFilesLock;
+	TSet<FString> StagedFiles;
+
+	bool StageFile(const FString& Filename, TConstArrayView64<uint8> Data);
+
+	FCriticalSection SharedPayloadLock;
+	TMap<FString, TWeakPtr<UE::NNE::FSharedModelData>> SharedPayloads;
+
 	bool LoadDLL();
 	void UnloadDLL();
 
 	void LogDevices();
+	void SetupModelCache();
+	void SetupWeightsMapping();
+	void SetupSharedModels();
+	void PrecompileAndExit();
 };
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include "Misc/IQueuedWork.h"
+#include "NNERuntimeCPU.h"
+#include "NNERuntimeGPU.h"
+#include "NNERuntimeNPU.h"
+#include "UObject/ObjectKey.h"
+
+#include <atomic>
+
+class FQueuedThreadPool;
+class UNNEModelData;
+
+enum class ENNERuntimeOpenVINODevice : uint8
+{
+	Cpu,
+	Gpu,
+	Npu
+};
+
+/**
+ * Compiles a batch of models on a bounded pool of background threads so they're ready before first use,
+ * e.g. while a level streams in. Ready instances are handed out with Acquire*. If the model is still compiling
+ * Acquire* waits for that compile, or runs it right away if it's still queued, instead of compiling a second copy.
+ * Only models that weren't preloaded are created synchronously.
+ *
+ * All functions must be called from the game thread.
+ */
+class NNERUNTIMEOPENVINO_API FNNERuntimeOpenVINOPreloader
+{
+public:
+	explicit FNNERuntimeOpenVINOPreloader(int32 MaxConcurrentCompiles = 2);
+	~FNNERuntimeOpenVINOPreloader();
+
+	/** Queues the models for compilation on the given device. Models already queued for that device are skipped. */
+	void Preload(TConstArrayView<TObjectPtr<UNNEModelData>> Models, ENNERuntimeOpenVINODevice Device, EQueuedWorkPriority Priority = EQueuedWorkPriority::Normal);
+
+	bool IsReady(const UNNEModelData* ModelData, ENNERuntimeOpenVINODevice Device) const;
+	bool IsComplete() const;
+
+	/** Fraction of queued models that finished compiling, successfully or not. */
+	float GetProgress() const;
+
+	TSharedPtr<UE::NNE::IModelInstanceCPU> AcquireInstanceCPU(UNNEModelData* ModelData);
+	TSharedPtr<UE::NNE::IModelInstanceGPU> AcquireInstanceGPU(UNNEModelData* ModelData);
+	TSharedPtr<UE::NNE::IModelInstanceNPU> AcquireInstanceNPU(UNNEModelData* ModelData);
+
+	/** Drops all preloaded instances. Compiles already running finish in the background, queued ones are skipped. */
+	void Reset();
+
+	static FString GetRuntimeName(ENNERuntimeOpenVINODevice Device);
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<UE::NNE::IModelCPU> ModelCPU;
+		TSharedPtr<UE::NNE::IModelGPU> ModelGPU;
+		TSharedPtr<UE::NNE::IModelNPU> ModelNPU;
+
+		TSharedPtr<UE::NNE::IModelInstanceCPU> InstanceCPU;
+		TSharedPtr<UE::NNE::IModelInstanceGPU> InstanceGPU;
+		TSharedPtr<UE::NNE::IModelInstanceNPU> InstanceNPU;
+
+		// Still queued work, cleared by the game thread once the entry is done. Only used to retract it.
+		IQueuedWork* Work = nullptr;
+		FEventRef DoneEvent{ EEventMode::ManualReset };
+
+		std::atomic<bool> bDone{ false };
+		std::atomic<bool> bCancelled{ false };
+	};
+
+	class FPreloadWork : public IQueuedWork
+	{
+	public:
+		explicit FPreloadWork(TSharedRef<FEntry> InEntry) : Entry(InEntry) {}
+
+		virtual void DoThreadedWork() override;
+		virtual void Abandon() override;
+
+	private:
+		TSharedRef<FEntry> Entry;
+	};
+
+	using FEntryKey = TPair<TObjectKey<UNNEModelData>, ENNERuntimeOpenVINODevice>;
+
+	TSharedPtr<FEntry> FindEntry(const UNNEModelData* ModelData, ENNERuntimeOpenVINODevice Device) const;
+
+	/** Waits for the entry's compile, running it on the calling thread if it hasn't started yet. */
+	void WaitForEntry(FEntry& Entry);
+
+	template<typename RuntimeType, typename ModelType, typename InstanceType>
+	TSharedPtr<InstanceType> AcquireInstance(UNNEModelData* ModelData, ENNERuntimeOpenVINODevice Device, TSharedPtr<ModelType> FEntry::* EntryModel, TSharedPtr<InstanceType> FEntry::* EntryInstance);
+
+	FQueuedThreadPool* ThreadPool = nullptr;
+	TMap<FEntryKey, TSharedRef<FEntry>> Entries;
+};
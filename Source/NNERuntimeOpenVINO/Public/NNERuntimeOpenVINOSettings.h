@@ -0,0 +1,283 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NNETypes.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "NNERuntimeOpenVINOSettings.generated.h"
+
+class UNNEModelData;
+
+UENUM()
+enum class ENNERuntimeOpenVINOColorFormat : uint8
+{
+	None,
+	RGB,
+	BGR,
+	RGBX,
+	BGRX,
+	Gray
+};
+
+/** Conversion of the data a caller passes for an input into what the model expects, built into the model by OpenVINO. */
+USTRUCT()
+struct FNNERuntimeOpenVINOInputPreProcess
+{
+	GENERATED_BODY()
+
+	/** Name of the input, as in the input tensor descs of the model. Empty for the only input of the model. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	FString Input;
+
+	/** Element type of the data the caller passes, None for the type of the model input. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	ENNETensorDataType ElementType = ENNETensorDataType::None;
+
+	/** Layout of the data the caller passes, e.g. NHWC. Converted to ModelLayout when both are set. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	FString TensorLayout;
+
+	/** Layout of the model input, e.g. NCHW, for models that don't declare it. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	FString ModelLayout;
+
+	/** Color format of the data the caller passes, converted to ModelColorFormat when both are set. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	ENNERuntimeOpenVINOColorFormat ColorFormat = ENNERuntimeOpenVINOColorFormat::None;
+
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	ENNERuntimeOpenVINOColorFormat ModelColorFormat = ENNERuntimeOpenVINOColorFormat::None;
+
+	/** Size of the images the caller passes, resized to the size of the model input. 0 to pass images of the model size. */
+	UPROPERTY(EditAnywhere, Category="PreProcess", meta=(ClampMin="0"))
+	int32 Width = 0;
+
+	UPROPERTY(EditAnywhere, Category="PreProcess", meta=(ClampMin="0"))
+	int32 Height = 0;
+
+	/** Subtracted from the data, one value for all channels or one per channel. Applied in FP32. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	TArray<float> Mean;
+
+	/** The data is divided by it after Mean is subtracted, one value for all channels or one per channel. Applied in FP32. */
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	TArray<float> Scale;
+};
+
+/**
+ * Conversion of an output of the model into what the caller reads, built into the model by OpenVINO.
+ * Hashed with the input preprocessing, so blobs precompiled at cook and cached compiled models match only the same conversions.
+ */
+USTRUCT()
+struct FNNERuntimeOpenVINOOutputPostProcess
+{
+	GENERATED_BODY()
+
+	/** Name of the output, as in the output tensor descs of the model. Empty for the only output of the model. */
+	UPROPERTY(EditAnywhere, Category="PostProcess")
+	FString Output;
+
+	/** Element type the caller reads the output in, e.g. Half to halve the size of FP32 outputs. */
+	UPROPERTY(EditAnywhere, Category="PostProcess")
+	ENNETensorDataType ElementType = ENNETensorDataType::None;
+};
+
+USTRUCT()
+struct FNNERuntimeOpenVINOModelPreProcess
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	TSoftObjectPtr<UNNEModelData> Model;
+
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	TArray<FNNERuntimeOpenVINOInputPreProcess> Inputs;
+
+	UPROPERTY(EditAnywhere, Category="PreProcess")
+	TArray<FNNERuntimeOpenVINOOutputPostProcess> Outputs;
+};
+
+UCLASS(config = NNERuntimeOpenVINO)
+class UNNERuntimeOpenVINOSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Compile each model for its target device while cooking and store the exported blob in the cooked model data.
+	 * At runtime the blob is imported directly, falling back to compiling from source if it doesn't match the machine.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cook")
+	bool bPrecompileOnCook;
+
+	/**
+	 * Compress the model, weights and precompiled blob of cooked model data in independent chunks.
+	 * Chunks are decompressed straight into an aligned buffer at load, so peak memory doesn't grow with the download size savings.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cook")
+	bool bCompressModelData;
+
+	/** Any format known to FCompression, e.g. Oodle or Zlib. */
+	UPROPERTY(Config, EditAnywhere, Category="Cook", meta=(EditCondition="bCompressModelData"))
+	FName ModelDataCompressionFormat;
+
+	/**
+	 * Cook the model and weights once, in the CPU runtime's model data. The GPU and NPU model data then only hold a
+	 * reference to it and their precompiled blobs, and all three share one copy in memory. Assets must target the CPU
+	 * runtime (or no runtime in particular) for the GPU and NPU runtimes to load them.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cook")
+	bool bShareCookedPayload;
+
+	/**
+	 * OpenVINO model conversion tool used to convert ONNX models to IR when cooking, e.g. ovc from the openvino Python
+	 * package, as a full path or a name on the PATH. Shipped clients then read IR and never run the ONNX frontend.
+	 * The converter must come from the same OpenVINO release as the bundled runtime, otherwise models are cooked as ONNX.
+	 * Models are also cooked as ONNX if this is empty. If the conversion itself fails, the model data isn't created.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cook")
+	FString OnnxConverter;
+
+	/**
+	 * IR models, or ONNX models converted to IR, to cook with FP32 constants stored as FP16. OpenVINO decompresses
+	 * them back to FP32 at compile time, so disk size and load bandwidth halve, but the weights lose precision.
+	 * Constants FP16 can't represent are kept in FP32. Check the outputs with bMeasureFp16Deviation.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cook")
+	TArray<TSoftObjectPtr<UNNEModelData>> Fp16Models;
+
+	/** Run the original and FP16 models on the CPU with the same input when cooking and log how far their outputs deviate. */
+	UPROPERTY(Config, EditAnywhere, Category="Cook")
+	bool bMeasureFp16Deviation;
+
+	/**
+	 * Calibration input for the FP16 deviation of each model, as a directory relative to the project unless absolute.
+	 * It holds one raw file per input named by its index (0.bin, 1.bin, ...), sized for the input's static shape.
+	 * Models without one are measured on seeded random input, which can under- or overstate the deviation.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cook", meta=(EditCondition="bMeasureFp16Deviation"))
+	TMap<TSoftObjectPtr<UNNEModelData>, FString> Fp16CalibrationInputs;
+
+	/**
+	 * Store models compiled in the editor in the Derived Data Cache, keyed by model content, device, OpenVINO version and compile properties.
+	 * Later sessions, and anyone sharing the DDC, import the cached blob instead of compiling again.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Editor")
+	bool bCacheCompiledModelsInDDC;
+
+	/**
+	 * Let OpenVINO cache compiled models on disk in CacheDirectory. Off by default, as the cache grows with every model and device it sees.
+	 * The cache can be filled ahead of time by running the game with -OpenVINOPrecompile, or with FNNERuntimeOpenVINO::WarmModelCache.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Cache")
+	bool bEnableModelCache;
+
+	/** Directory OpenVINO caches compiled models in, relative to the project Saved directory unless absolute. */
+	UPROPERTY(Config, EditAnywhere, Category="Cache", meta=(EditCondition="bEnableModelCache"))
+	FString CacheDirectory;
+
+	/**
+	 * Number of inferences to run with zero inputs when a model instance is created, 0 to disable.
+	 * Moves kernel JIT, page faults and thread pool start-up out of the first real inference. Models with dynamic inputs are skipped.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Runtime", meta=(ClampMin="0"))
+	int32 WarmUpInferences;
+
+	/**
+	 * Memory in MB compiled models may use before the least recently used idle ones are released, 0 for no limit.
+	 * A released model is restored on its next inference, from the precompiled blob or cache when available.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Runtime", meta=(ClampMin="0"))
+	int32 MemoryBudgetMB;
+
+	/**
+	 * Drop the plugin's references to a model's source data once it's compiled, where compiled models don't read it anymore:
+	 * GPU and NPU models, which copy their constants, and CPU models whose weights are mapped from staged files (bMemoryMapWeights,
+	 * bShareCompiledModelsAcrossProcesses) or run in the inference daemon. CPU models read from memory use the weights in place, so they keep it.
+	 * This frees nothing by itself: the asset keeps its own copy while loaded, and the memory is only returned once it's unloaded too.
+	 * The data is loaded again from the asset only if the model has to be recompiled, e.g. after the memory budget evicts it.
+	 * That reload fails with an error if the asset is unloaded and the recompile isn't on the game thread.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Runtime")
+	bool bReleaseModelDataAfterCompile;
+
+	/**
+	 * Stage IR models as standalone files in WeightsDirectory and let OpenVINO memory map the weights instead of copying them.
+	 * The OS then pages weights in on demand, shares them between processes and can evict them under memory pressure.
+	 * The weights are still loaded with the model data and copied to disk the first time, which for large models means
+	 * gigabytes written to WeightsDirectory. The memory is only saved once the model data is released, see bReleaseModelDataAfterCompile.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Runtime")
+	bool bMemoryMapWeights;
+
+	/** Directory staged IR models are written to, relative to the project Saved directory unless absolute. */
+	UPROPERTY(Config, EditAnywhere, Category="Runtime", meta=(EditCondition="bMemoryMapWeights"))
+	FString WeightsDirectory;
+
+	/**
+	 * Preprocessing OpenVINO builds into the models of these assets, e.g. so callers can pass U8 NHWC images to a
+	 * model taking normalized FP32 NCHW tensors. OpenVINO fuses the conversion into the first layers of the model.
+	 * Outputs can be given another element type the same way. Blobs precompiled at cook include it, and compiled models
+	 * are cached and shared per model and pre and postprocessing.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Runtime")
+	TArray<FNNERuntimeOpenVINOModelPreProcess> PreProcessing;
+
+	/**
+	 * Compile CPU models through a store shared by every process on the host, e.g. co-located dedicated servers.
+	 * Compiled models are cached in SharedModelDirectory and memory mapped, so their constants occupy the same
+	 * page cache pages in every process. Use OpenVINO.MemoryReport to compare per-process memory.
+	 * CPU models are then cached in SharedModelDirectory instead of CacheDirectory, and warming the model cache fills the shared store.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Server")
+	bool bShareCompiledModelsAcrossProcesses;
+
+	/** Directory shared by the processes, relative to the project Saved directory unless absolute. Every process must use the same path. */
+	UPROPERTY(Config, EditAnywhere, Category="Server", meta=(EditCondition="bShareCompiledModelsAcrossProcesses || bUseInferenceDaemon"))
+	FString SharedModelDirectory;
+
+	/**
+	 * Run CPU model instances in a daemon process started with -OpenVINODaemon instead of in this process.
+	 * The daemon compiles each model once for every process on the host and batches their requests; tensors are
+	 * exchanged through shared memory. Falls back to in-process inference when no daemon is running.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category="Server")
+	bool bUseInferenceDaemon;
+
+	/** Name of the shared memory and semaphores of the daemon, must match between the daemon and its clients. */
+	UPROPERTY(Config, EditAnywhere, Category="Server")
+	FString InferenceDaemonName;
+
+	/** Size of the shared memory channel of each model instance, must fit all of its input and output tensors. */
+	UPROPERTY(Config, EditAnywhere, Category="Server", meta=(ClampMin="1", EditCondition="bUseInferenceDaemon"))
+	int32 InferenceDaemonChannelMB;
+
+private:
+};
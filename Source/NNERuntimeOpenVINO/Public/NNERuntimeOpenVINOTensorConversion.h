@@ -0,0 +1,65 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Float16.h"
+
+/**
+ * Host side conversions for filling tensor bindings when the conversion can't be built into the model with the
+ * preprocessing settings. They use SSE where the platform has it and fall back to scalar loops with the same results
+ * otherwise. Unless stated, the source and destination must not overlap. Conversions log and return false when the
+ * sizes don't match. The OpenVINO.BenchmarkConversions console command compares them with scalar references.
+ */
+namespace UE::NNERuntimeOpenVINO::TensorConversion
+{
+	/**
+	 * Converts RGBA8 pixels into NumChannels float planes, the NHWC to NCHW conversion of one image, and computes
+	 * (Value - Mean) / Scale per channel. NumChannels is 3 to drop alpha or 4 to keep it. Mean and Scale hold one value
+	 * for all channels or one per channel, and default to 0 and 1. With bSwapRedBlue the planes are in BGR(A) order.
+	 */
+	NNERUNTIMEOPENVINO_API bool RGBA8ToPlanarFloat(TConstArrayView<uint8> Src, TArrayView<float> Dst, int32 NumChannels, TConstArrayView<float> Mean = {}, TConstArrayView<float> Scale = {}, bool bSwapRedBlue = false);
+
+	/** Converts the interleaved (NHWC) channels of one image into planes (NCHW). */
+	NNERUNTIMEOPENVINO_API bool InterleavedToPlanar(TConstArrayView<float> Src, TArrayView<float> Dst, int32 NumChannels);
+
+	/** Converts the planes (NCHW) of one image into interleaved (NHWC) channels. */
+	NNERUNTIMEOPENVINO_API bool PlanarToInterleaved(TConstArrayView<float> Src, TArrayView<float> Dst, int32 NumChannels);
+
+	/**
+	 * Reorders the channels of 4 channel 8 bit pixels, channel i of Dst taking channel Order[i] of Src, e.g. {2, 1, 0, 3}
+	 * for RGBA to BGRA. Src and Dst may be the same memory.
+	 */
+	NNERUNTIMEOPENVINO_API bool SwizzleChannels8(TConstArrayView<uint8> Src, TArrayView<uint8> Dst, const uint8 (&Order)[4]);
+
+	NNERUNTIMEOPENVINO_API bool FloatToHalf(TConstArrayView<float> Src, TArrayView<FFloat16> Dst);
+	NNERUNTIMEOPENVINO_API bool HalfToFloat(TConstArrayView<FFloat16> Src, TArrayView<float> Dst);
+
+	/** BF16 values are the upper 16 bits of FP32 values, rounded to nearest even. NaNs stay NaNs. */
+	NNERUNTIMEOPENVINO_API bool FloatToBFloat16(TConstArrayView<float> Src, TArrayView<uint16> Dst);
+	NNERUNTIMEOPENVINO_API bool BFloat16ToFloat(TConstArrayView<uint16> Src, TArrayView<float> Dst);
+}
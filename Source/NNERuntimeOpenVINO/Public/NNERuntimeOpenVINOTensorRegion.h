@@ -0,0 +1,48 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Binds a tensor to a region of a larger CPU buffer, e.g. a crop of a frame or one slice of a batched buffer.
+ * Only regions whose elements are contiguous, such as a slice of the outermost dimension, are bound in place.
+ * Others, such as a crop, are copied through a dense buffer the instance keeps between runs.
+ * The extents of the region are the shape of the tensor it's bound to: the shape set for an input, the output
+ * tensor shapes or the model's shape for an output. The buffer must hold every element the region reaches.
+ */
+struct FNNERuntimeOpenVINOTensorRegion
+{
+	/** Start of the buffer the region is in. */
+	void* Data = nullptr;
+
+	/** Bytes between consecutive indices of each dimension of the buffer, outermost first. Empty for a dense tensor at Data. */
+	TArray<uint64, TInlineAllocator<8>> Strides;
+
+	/** Index of the first element of the region in each dimension of the buffer, or empty to start at Data. */
+	TArray<uint64, TInlineAllocator<8>> Origin;
+};
@@ -40,6 +40,7 @@ public class NNERuntimeOpenVINOEditor : ModuleRules
 				"UnrealEd",
 				"NNE",
 				"NNEEditor", // For importing ONNX files.
+				"NNERuntimeOpenVINO",
 			}
 		);
 	}
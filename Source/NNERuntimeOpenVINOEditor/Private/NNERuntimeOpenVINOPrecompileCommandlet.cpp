@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+#include "NNERuntimeOpenVINOPrecompileCommandlet.h"
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "NNEModelData.h"
+#include "NNERuntimeOpenVINOModule.h"
+#include "NNERuntimeOpenVINOSettings.h"
+
+#include "NNERuntimeOpenVINOEditorModule.h"
+
+UNNERuntimeOpenVINOPrecompileCommandlet::UNNERuntimeOpenVINOPrecompileCommandlet(const FObjectInitializer& ObjectInitializer) : UCommandlet(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNNERuntimeOpenVINOPrecompileCommandlet::Main(const FString& Params)
+{
+	FNNERuntimeOpenVINO* OpenVINOModule = FModuleManager::GetModulePtr<FNNERuntimeOpenVINO>(FNNERuntimeOpenVINO::ModuleName());
+	if (!OpenVINOModule)
+	{
+		UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("The NNERuntimeOpenVINO module is not loaded."));
+		return 1;
+	}
+
+	if (OpenVINOModule->GetCacheDirectory().IsEmpty())
+	{
+		UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("The OpenVINO model cache is disabled, enable bEnableModelCache in the NNERuntimeOpenVINO settings."));
+		return 1;
+	}
+
+	// A DDC hit imports the compiled model without compiling it, which would leave the OpenVINO cache empty.
+	// The setting is restored afterwards so the editor settings aren't left modified.
+	TGuardValue<bool> DisableDDC(GetMutableDefault<UNNERuntimeOpenVINOSettings>()->bCacheCompiledModelsInDDC, false);
+
+	TArray<TObjectPtr<UNNEModelData>> Models;
+	FString ModelPath;
+	if (FParse::Value(*Params, TEXT("Model="), ModelPath))
+	{
+		UNNEModelData* ModelData = LoadObject<UNNEModelData>(nullptr, *ModelPath);
+		if (!ModelData)
+		{
+			UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("Failed to load model %s."), *ModelPath);
+			return 1;
+		}
+		Models.Add(ModelData);
+	}
+	else
+	{
+		Models = FNNERuntimeOpenVINO::LoadModelAssets();
+	}
+
+	const int32 NumCompiled = OpenVINOModule->WarmModelCache(Models);
+	UE_LOG(LogNNERuntimeOpenVINOEditor, Display, TEXT("Precompiled %d model(s) into %s."), NumCompiled, *OpenVINOModule->GetCacheDirectory());
+
+	return 0;
+}
@@ -26,13 +26,19 @@
 
 #include "CoreMinimal.h"
 #include "Editor.h"
+#include "HAL/FileManager.h"
+#include "Misc/ScopedSlowTask.h"
 #include "NNE.h"
 #include "NNEModelData.h"
-#include "Serialization/MemoryWriter.h"
 #include "Subsystems/ImportSubsystem.h"
+#include "Tasks/Task.h"
 
 #include "NNERuntimeOpenVINOEditorModule.h"
 
+#include <atomic>
+
+#define LOCTEXT_NAMESPACE "NNERuntimeOpenVINOModelDataFactory"
+
 bool IsFileSupported(const FString& FileType)
 {
 	/*
@@ -43,6 +49,37 @@ bool IsFileSupported(const FString& FileType)
 	return FileType.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0;
 }
 
+// Reads the file in chunks straight into its place in the asset payload, so no intermediate copy is ever held.
+static bool StreamFileInto(const FString& Filename, TArrayView64<uint8> Destination, std::atomic<int64>& BytesRead, const std::atomic<bool>& bCancel)
+{
+	constexpr int64 ChunkSize = 16 * 1024 * 1024;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader || Reader->TotalSize() != Destination.Num())
+	{
+		return false;
+	}
+
+	for (int64 Offset = 0; Offset < Destination.Num(); Offset += ChunkSize)
+	{
+		if (bCancel)
+		{
+			return false;
+		}
+
+		const int64 Size = FMath::Min(ChunkSize, Destination.Num() - Offset);
+		Reader->Serialize(Destination.GetData() + Offset, Size);
+		if (Reader->IsError())
+		{
+			return false;
+		}
+
+		BytesRead += Size;
+	}
+
+	return Reader->Close();
+}
+
 UNNERuntimeOpenVINOModelDataFactory::UNNERuntimeOpenVINOModelDataFactory(const FObjectInitializer& ObjectInitializer) : UFactory(ObjectInitializer)
 {
 	bCreateNew = false;
@@ -69,38 +106,72 @@ UObject* UNNERuntimeOpenVINOModelDataFactory::FactoryCreateFile(UClass* InClass,
 		return nullptr;
 	}
 
-	TArray64<uint8> FileData;
-	if (!FFileHelper::LoadFileToArray(FileData, *Filename))
+	const int64 FileDataBytes = IFileManager::Get().FileSize(*Filename);
+	if (FileDataBytes <= 0)
 	{
 		UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("Failed to load file '%s'"), *Filename);
 		GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
 		return nullptr;
 	}
 
-	TMap<FString, TConstArrayView64<uint8>> AdditionalBuffers;
-	TArray64<uint8> WeightData;
+	const bool bHasWeights = FileExtension.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0;
+	const FString BinFilename(FPaths::ChangeExtension(Filename, "bin"));
+	const int64 WeightDataBytes = bHasWeights ? IFileManager::Get().FileSize(*BinFilename) : 0;
+	if (WeightDataBytes < 0)
+	{
+		UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("Failed to load additional binary xml data from file '%s'"), *BinFilename);
+		GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+		return nullptr;
+	}
 
-	if (FileExtension.Compare(TEXT("xml"), ESearchCase::IgnoreCase) == 0)
+	// The XML and BIN sizes followed by both files, in one contiguous blob for easy serialization in packaged builds.
+	// The blob is allocated once at its final size and the files are streamed into it.
+	TArray64<uint8> SerializedFileData;
+	const int64 HeaderBytes = sizeof(FileDataBytes) + sizeof(WeightDataBytes);
+	SerializedFileData.SetNumUninitialized(HeaderBytes + FileDataBytes + WeightDataBytes);
+	FMemory::Memcpy(SerializedFileData.GetData(), &FileDataBytes, sizeof(FileDataBytes));
+	FMemory::Memcpy(SerializedFileData.GetData() + sizeof(FileDataBytes), &WeightDataBytes, sizeof(WeightDataBytes));
+
+	std::atomic<int64> BytesRead{ 0 };
+	std::atomic<bool> bCancel{ false };
+	UE::Tasks::TTask<bool> ReadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&]()
 	{
-		const FString BinFilename(FPaths::ChangeExtension(Filename, "bin"));
-		if (!FFileHelper::LoadFileToArray(WeightData, *BinFilename))
+		TArrayView64<uint8> Payload(SerializedFileData.GetData() + HeaderBytes, FileDataBytes + WeightDataBytes);
+		return StreamFileInto(Filename, Payload.Left(FileDataBytes), BytesRead, bCancel)
+			&& (!bHasWeights || StreamFileInto(BinFilename, Payload.Right(WeightDataBytes), BytesRead, bCancel));
+	});
+
+	{
+		FScopedSlowTask SlowTask((float)(FileDataBytes + WeightDataBytes), FText::Format(LOCTEXT("ImportingModel", "Importing {0}"), FText::FromString(FPaths::GetCleanFilename(Filename))));
+		SlowTask.MakeDialog(true);
+
+		int64 BytesReported = 0;
+		while (!ReadTask.Wait(FTimespan::FromMilliseconds(100)))
 		{
-			UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("Failed to load additional binary xml data from file '%s'"), *BinFilename);
-			GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
-			return nullptr;
+			const int64 CurrentBytes = BytesRead;
+			SlowTask.EnterProgressFrame((float)(CurrentBytes - BytesReported));
+			BytesReported = CurrentBytes;
+
+			if (SlowTask.ShouldCancel())
+			{
+				bCancel = true;
+			}
 		}
 	}
 
-	// FileData contains the XML model, WeightData contains the BIN weights.
-	// Store everything into one contiguous blob for easy serialization in packaged builds.
-	TArray64<uint8> SerializedFileData;
-	FMemoryWriter64 MemoryWriter(SerializedFileData, true);
-	int64 FileDataBytes = FileData.NumBytes();
-	int64 WeightDataBytes = WeightData.NumBytes();
-	MemoryWriter.Serialize(&FileDataBytes, sizeof(FileDataBytes));
-	MemoryWriter.Serialize(&WeightDataBytes, sizeof(WeightDataBytes));
-	MemoryWriter.Serialize(FileData.GetData(), FileDataBytes);
-	MemoryWriter.Serialize(WeightData.GetData(), WeightDataBytes);
+	if (bCancel)
+	{
+		bOutOperationCanceled = true;
+		GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+		return nullptr;
+	}
+
+	if (!ReadTask.GetResult())
+	{
+		UE_LOG(LogNNERuntimeOpenVINOEditor, Error, TEXT("Failed to read model '%s'"), *Filename);
+		GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+		return nullptr;
+	}
 
 	UNNEModelData* ModelData = NewObject<UNNEModelData>(InParent, InClass, InName, Flags);
 	check(ModelData)
@@ -131,3 +202,5 @@ bool UNNERuntimeOpenVINOModelDataFactory::FactoryCanImport(const FString& Filena
 
 	return true;
 }
+
+#undef LOCTEXT_NAMESPACE
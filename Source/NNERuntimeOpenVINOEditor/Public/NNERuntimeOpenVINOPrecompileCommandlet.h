@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright (C) 2025 Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom
+* the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+* OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "NNERuntimeOpenVINOPrecompileCommandlet.generated.h"
+
+/**
+ * Compiles every OpenVINO model asset for the devices available on this machine to fill the OpenVINO cache.
+ * This needs the editor, so it's meant for development and build machines:
+ *   UnrealEditor-Cmd.exe Project.uproject -run=NNERuntimeOpenVINOPrecompile [-Model=/Game/Path/Asset]
+ * Player machines run the packaged game with -OpenVINOPrecompile instead.
+ */
+UCLASS()
+class NNERUNTIMEOPENVINOEDITOR_API UNNERuntimeOpenVINOPrecompileCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UNNERuntimeOpenVINOPrecompileCommandlet(const FObjectInitializer& ObjectInitializer);
+
+public:
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};